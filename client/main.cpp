@@ -24,12 +24,15 @@
  //////////////
 
 #include <filesystem>
+#include <charconv>
+#include <cstring>
 // Library header:
 #include "engine.h"
 
 Eng::Base& eng = Eng::Base::getInstance();
 
 #define FILE_NAME "newScene.ovo"
+#define BENCH_MAX_NODES 100000 ///< Largest synthetic scene accepted by --bench (the hierarchy benchmark uses 10 times as many nodes)
 
 // Object blinking vars
 Eng::Node* pickedObject = nullptr;
@@ -41,7 +44,7 @@ bool blink = false;
 bool blinkerTimerStarted = false;
 
 // List with all elements
-std::list<Eng::Node*> list;
+std::span<Eng::Node* const> list;
 
 // Other vars
 Eng::Camera* cameras[1];
@@ -188,6 +191,27 @@ int main(int argc, char* argv[])
     std::cout << "Chessboard VR Project - Group 4" << std::endl;
     std::cout << std::endl;
 
+    // Synthetic CPU benchmark (no window needed):
+    if (argc > 1 && std::string(argv[1]) == "--bench")
+    {
+        unsigned int nodes = 10000;
+        if (argc > 2)
+        {
+            // Digits only: no sign, no trailing characters, within range:
+            const char* text = argv[2];
+            const char* end = text + strlen(text);
+            const std::from_chars_result result = std::from_chars(text, end, nodes);
+            if (result.ec != std::errc() || result.ptr != end || nodes == 0 || nodes > BENCH_MAX_NODES)
+            {
+                std::cerr << "Usage: " << argv[0] << " --bench [nodes]" << std::endl;
+                std::cerr << "   nodes: size of the synthetic scene, 1 to " << BENCH_MAX_NODES << " (default 10000)" << std::endl;
+                return -1;
+            }
+        }
+        Eng::Benchmark::run(nodes);
+        return 0;
+    }
+
     // Initialize the engine
     if (!eng.init(argc, argv, "Chessboard project"))
     {
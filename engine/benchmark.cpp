@@ -0,0 +1,347 @@
+/**
+* @file benchmark.cpp
+* @brief Implementation of the Benchmark class
+*
+* This file contains the implementation of the Benchmark class methods.
+*
+* @see Benchmark
+* @see benchmark.h
+*
+* @date 2025
+*
+* @details The synthetic scene is a forest of shallow hierarchies made of rigid transforms with a uniform scale,
+* which is what the loaded .ovo scenes look like.
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+#include "engine.h"
+
+/**
+* @brief Elapsed time since a start point, in milliseconds
+*/
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+   return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/**
+* @brief Run all the benchmarks
+*
+* The hierarchy benchmark uses 10 times as many nodes, about half a kilobyte each.
+*
+* @param nodes The number of nodes of the synthetic scene.
+* @param frames The number of simulated frames.
+*/
+void ENG_API Eng::Benchmark::run(unsigned int nodes, unsigned int frames) {
+   std::cout << "[Benchmark] " << nodes << " nodes, " << frames << " frames, kernels: " << MathKernels::getInstructionSet() << std::endl;
+   matrices(nodes, frames);
+   hierarchy(nodes * 10, frames);
+   culling(frames);
+   uniforms(nodes, frames);
+}
+
+/**
+* @brief Benchmark the per-frame matrix work
+*
+* Compares plain glm against the MathKernels for world matrix composition, rigid inverse and
+* normal matrix derivation on a synthetic hierarchy.
+*
+* @param nodes The number of nodes of the synthetic scene.
+* @param frames The number of simulated frames.
+*/
+void ENG_API Eng::Benchmark::matrices(unsigned int nodes, unsigned int frames) {
+   if (nodes == 0 || frames == 0)
+      return;
+
+   // Synthetic hierarchy: every node hangs from one of the previous 8 nodes, roots every 64 nodes:
+   std::vector<int> parents(nodes);
+   std::vector<glm::mat4> locals(nodes);
+   for (unsigned int i = 0; i < nodes; i++) {
+      parents[i] = (i % 64 == 0) ? -1 : (int)(i - 1 - (i % 8));
+      glm::mat4 m = glm::translate(glm::mat4(1.0f), glm::vec3((float)(i % 13), (float)(i % 7), (float)(i % 5)) * 0.1f);
+      m = glm::rotate(m, glm::radians((float)(i % 360)), glm::normalize(glm::vec3(1.0f, (float)(i % 3), 0.5f)));
+      locals[i] = glm::scale(m, glm::vec3(1.0f + (float)(i % 4) * 0.05f));
+   }
+   std::vector<glm::mat4> worlds(nodes), parentWorlds(nodes);
+   std::vector<glm::mat3> normals(nodes);
+   const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.7f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+   float sink = 0.0f;
+
+   // World matrix composition:
+   auto start = std::chrono::high_resolution_clock::now();
+   for (unsigned int f = 0; f < frames; f++)
+      for (unsigned int i = 0; i < nodes; i++)
+         worlds[i] = parents[i] >= 0 ? worlds[parents[i]] * locals[i] : locals[i];
+   double reference = elapsedMs(start) / frames;
+   sink += worlds[nodes - 1][3][0];
+
+   start = std::chrono::high_resolution_clock::now();
+   for (unsigned int f = 0; f < frames; f++)
+      for (unsigned int i = 0; i < nodes; i++)
+         if (parents[i] >= 0)
+            MathKernels::multiply(worlds[parents[i]], locals[i], worlds[i]);
+         else
+            worlds[i] = locals[i];
+   double optimized = elapsedMs(start) / frames;
+   sink += worlds[nodes - 1][3][0];
+   print("world composition", reference, optimized);
+
+   // Batched composition (parents already gathered, as the modelview pass does):
+   for (unsigned int i = 0; i < nodes; i++)
+      parentWorlds[i] = parents[i] >= 0 ? worlds[parents[i]] : glm::mat4(1.0f);
+
+   start = std::chrono::high_resolution_clock::now();
+   for (unsigned int f = 0; f < frames; f++)
+      for (unsigned int i = 0; i < nodes; i++)
+         worlds[i] = parentWorlds[i] * locals[i];
+   reference = elapsedMs(start) / frames;
+   sink += worlds[nodes - 1][3][0];
+
+   start = std::chrono::high_resolution_clock::now();
+   for (unsigned int f = 0; f < frames; f++)
+      MathKernels::multiplyBatch(parentWorlds.data(), locals.data(), worlds.data(), nodes);
+   optimized = elapsedMs(start) / frames;
+   sink += worlds[nodes - 1][3][0];
+   print("batched composition", reference, optimized);
+
+   // Rigid inverse (cameras, eyes, HMD), one per node to make it measurable:
+   std::vector<glm::mat4> rigids(nodes), inverses(nodes);
+   for (unsigned int i = 0; i < nodes; i++)
+      rigids[i] = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(locals[i][3])), glm::radians((float)i), glm::vec3(0.0f, 1.0f, 0.0f));
+
+   start = std::chrono::high_resolution_clock::now();
+   for (unsigned int f = 0; f < frames; f++)
+      for (unsigned int i = 0; i < nodes; i++)
+         inverses[i] = glm::inverse(rigids[i]);
+   reference = elapsedMs(start) / frames;
+   sink += inverses[nodes - 1][3][0];
+
+   start = std::chrono::high_resolution_clock::now();
+   for (unsigned int f = 0; f < frames; f++)
+      MathKernels::rigidInverseBatch(rigids.data(), inverses.data(), nodes);
+   optimized = elapsedMs(start) / frames;
+   sink += inverses[nodes - 1][3][0];
+   print("rigid inverse", reference, optimized);
+
+   // Normal matrices of the modelview matrices:
+   start = std::chrono::high_resolution_clock::now();
+   for (unsigned int f = 0; f < frames; f++)
+      for (unsigned int i = 0; i < nodes; i++)
+         normals[i] = glm::inverseTranspose(glm::mat3(view * worlds[i]));
+   reference = elapsedMs(start) / frames;
+   sink += normals[nodes - 1][0][0];
+
+   start = std::chrono::high_resolution_clock::now();
+   glm::mat4 modelView;
+   for (unsigned int f = 0; f < frames; f++)
+      for (unsigned int i = 0; i < nodes; i++) {
+         MathKernels::multiply(view, worlds[i], modelView);
+         normals[i] = MathKernels::normalMatrix(modelView);
+      }
+   optimized = elapsedMs(start) / frames;
+   sink += normals[nodes - 1][0][0];
+   print("normal matrix", reference, optimized);
+
+   // Keeps the compiler from dropping the loops:
+   if (sink == 12345.678f)
+      std::cout << sink << std::endl;
+}
+
+/**
+* @brief Benchmark the parallel transform and bounds update
+*
+* Updates a synthetic scene made of independent subtrees with an increasing number of threads
+* and checks that the result matches the serial update.
+*
+* @param nodes The number of nodes of the synthetic scene.
+* @param frames The number of simulated frames.
+*/
+void ENG_API Eng::Benchmark::hierarchy(unsigned int nodes, unsigned int frames) {
+   const unsigned int subtrees = 64;
+   if (nodes < subtrees || frames == 0)
+      return;
+
+   // One root with 64 subtrees, like the board and the pieces of a loaded scene.
+   // The deque owns the nodes and keeps their addresses stable:
+   std::deque<Node> storage;
+   Node* root = &storage.emplace_back("[root]");
+   std::vector<Node*> all;
+   all.reserve(nodes);
+   for (unsigned int i = 0; i < nodes; i++) {
+      Node* node = &storage.emplace_back("node");
+      glm::mat4 m = glm::translate(glm::mat4(1.0f), glm::vec3(0.1f, (float)(i % 7) * 0.01f, 0.0f));
+      node->setTransform(glm::rotate(m, glm::radians((float)(i % 90)), glm::vec3(0.0f, 1.0f, 0.0f)));
+      // Node i belongs to subtree i % 64 and hangs from one of the previous 4 nodes of the same subtree:
+      if (i < subtrees)
+         root->addChild(node);
+      else {
+         const unsigned int back = subtrees * (1 + (i / subtrees) % 4);
+         all[i >= back ? i - back : i - subtrees]->addChild(node);
+      }
+      all.push_back(node);
+   }
+
+   List list;
+   list.addEntry(root);
+   list.setParallelThreshold(0);
+
+   // Serial reference:
+   list.setUpdateThreads(1);
+   root->setDirty();
+   list.updateWorldTransforms();
+   std::vector<glm::mat4> reference(nodes);
+   for (unsigned int i = 0; i < nodes; i++)
+      reference[i] = all[i]->getFinalMatrix();
+
+   std::cout << "   parallel update (" << nodes << " nodes, " << subtrees << " subtrees):" << std::endl;
+   double serial = 0.0;
+   const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+   for (unsigned int threads = 1; threads <= hardwareThreads; threads *= 2) {
+      list.setUpdateThreads(threads);
+
+      double total = 0.0;
+      for (unsigned int f = 0; f < frames; f++) {
+         root->setDirty();
+         auto start = std::chrono::high_resolution_clock::now();
+         list.updateWorldTransforms();
+         total += elapsedMs(start);
+      }
+      const double perFrame = total / frames;
+      if (threads == 1)
+         serial = perFrame;
+
+      bool identical = true;
+      for (unsigned int i = 0; i < nodes && identical; i++)
+         identical = memcmp(&reference[i], &all[i]->getFinalMatrix(), sizeof(glm::mat4)) == 0;
+
+      std::cout << "      " << threads << " threads: " << perFrame << " ms/frame (x" << (perFrame > 0.0 ? serial / perFrame : 0.0)
+         << ")" << (identical ? "" : " [MISMATCH]") << std::endl;
+   }
+
+   // The nodes belong to the storage: the list is dropped without clear(), which deletes them
+   list.setUpdateThreads(0);
+}
+
+/**
+* @brief Benchmark the frustum culling kernels
+*
+* Tests 1k, 10k and 100k random spheres with Frustum::sphereInFrustum() and with the batched
+* SIMD kernel, reports the throughput in spheres per second and checks that the masks match.
+*
+* @param frames The number of simulated frames.
+*/
+void ENG_API Eng::Benchmark::culling(unsigned int frames) {
+   if (frames == 0)
+      return;
+
+   const glm::mat4 projection = glm::perspective(glm::radians(80.0f), 1.0f, 0.01f, 1000.0f);
+   const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.7f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+   const Frustum frustum = extractFrustumPlanes(projection * view);
+
+   std::cout << "   frustum culling (" << MathKernels::getInstructionSet() << "):" << std::endl;
+   for (unsigned int count : { 1000u, 10000u, 100000u }) {
+      // Spheres scattered around the camera, about a fifth of them visible:
+      SphereArrays spheres;
+      unsigned int seed = 12345;
+      auto random = [&seed]() {
+         seed = seed * 1664525u + 1013904223u;
+         return (float)(seed >> 8) / 16777216.0f;
+      };
+      for (unsigned int i = 0; i < count; i++) {
+         const glm::vec3 center(random() * 200.0f - 100.0f, random() * 20.0f - 10.0f, random() * 200.0f - 100.0f);
+         spheres.push(center, 0.05f + random() * 2.0f);
+      }
+
+      std::vector<unsigned int> reference((count + 31) / 32), mask;
+
+      auto start = std::chrono::high_resolution_clock::now();
+      for (unsigned int f = 0; f < frames; f++) {
+         std::fill(reference.begin(), reference.end(), 0u);
+         for (unsigned int i = 0; i < count; i++)
+            if (frustum.sphereInFrustum(glm::vec3(spheres.x[i], spheres.y[i], spheres.z[i]), spheres.radius[i]))
+               reference[i / 32] |= 1u << (i % 32);
+      }
+      const double scalar = elapsedMs(start) / frames;
+
+      start = std::chrono::high_resolution_clock::now();
+      for (unsigned int f = 0; f < frames; f++)
+         frustum.testSpheres(spheres, mask);
+      const double batched = elapsedMs(start) / frames;
+
+      unsigned int visible = 0;
+      for (unsigned int word : mask)
+         visible += (unsigned int)std::popcount(word);
+
+      auto rate = [count](double ms) { return ms > 0.0 ? count / ms / 1000.0 : 0.0; };
+      std::cout << "      " << count << " spheres (" << visible << " visible): "
+         << rate(scalar) << " -> " << rate(batched) << " Mspheres/s";
+      if (batched > 0.0)
+         std::cout << " (x" << scalar / batched << ")";
+      std::cout << (reference == mask ? "" : " [MISMATCH]") << std::endl;
+   }
+}
+
+/**
+* @brief Benchmark the uniform location lookup
+*
+* Compares Shader::locate(), the lookup of the setters by name, against the slot table of the
+* uniform identifiers, on a program reflected without GL.
+*
+* @param draws The number of draws per frame.
+* @param frames The number of simulated frames.
+*/
+void ENG_API Eng::Benchmark::uniforms(unsigned int draws, unsigned int frames) {
+   if (draws == 0 || frames == 0)
+      return;
+
+   // Active uniforms of the forward program before the uniform blocks, reflected as Shader::build() does:
+   static const char* names[] = { "projection", "modelview", "normalMatrix", "matAmbient", "matDiffuse", "matSpecular",
+      "matShininess", "lightPosition", "lightAmbient", "lightDiffuse", "lightSpecular", "texSampler" };
+   Shader shader;
+   for (int i = 0; i < (int)std::size(names); i++)
+      shader.bindingMap.emplace(names[i], i);
+   shader.resolveSlots();
+
+   // The locations are summed and printed, so neither loop can be dropped:
+   long long byNameSum = 0;
+   auto start = std::chrono::high_resolution_clock::now();
+   for (unsigned int f = 0; f < frames; f++)
+      for (unsigned int d = 0; d < draws; d++) {
+         byNameSum += shader.locate("modelview");
+         byNameSum += shader.locate("normalMatrix");
+      }
+   const double byName = elapsedMs(start) / frames;
+
+   long long bySlotSum = 0;
+   start = std::chrono::high_resolution_clock::now();
+   for (unsigned int f = 0; f < frames; f++)
+      for (unsigned int d = 0; d < draws; d++) {
+         bySlotSum += shader.getUniformLocation(Shader::UNIFORM_MODELVIEW);
+         bySlotSum += shader.getUniformLocation(Shader::UNIFORM_NORMAL_MATRIX);
+      }
+   const double bySlot = elapsedMs(start) / frames;
+
+   auto perSet = [draws](double ms) { return ms * 1000000.0 / (draws * 2.0); };
+   std::cout << "   uniform lookup (" << draws << " draws): " << perSet(byName) << " -> " << perSet(bySlot) << " ns/set";
+   if (bySlot > 0.0)
+      std::cout << " (x" << byName / bySlot << ")";
+   std::cout << " [sum " << bySlotSum << (byNameSum == bySlotSum ? "" : ", MISMATCH") << "]" << std::endl;
+}
+
+/**
+* @brief Print a timing line
+*
+* @param label The name of the measured task.
+* @param reference The reference time, in milliseconds per frame.
+* @param optimized The optimized time, in milliseconds per frame.
+*/
+void Eng::Benchmark::print(const char* label, double reference, double optimized) {
+   std::cout << "   " << label << ": " << reference << " ms/frame -> " << optimized << " ms/frame";
+   if (optimized > 0.0)
+      std::cout << " (x" << reference / optimized << ")";
+   std::cout << std::endl;
+}
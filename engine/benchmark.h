@@ -0,0 +1,97 @@
+/**
+* @file benchmark.h
+* @brief Benchmark class header file
+*
+* This file contains the definition of the Benchmark class, a set of synthetic CPU benchmarks for the
+* per-frame work of the engine.
+*
+* @date 2025
+*
+* @details The benchmarks run without a GL context and print their timings on the standard output.
+* @see Eng::MathKernels, Eng::TransformStore, Eng::Shader
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "engine.h"
+
+/**
+* @brief Benchmark class
+*
+* Static entry points for the synthetic benchmarks.
+*/
+class ENG_API Benchmark {
+public:
+   /**
+   * @brief Run all the benchmarks
+   *
+   * The hierarchy benchmark uses 10 times as many nodes, about half a kilobyte each.
+   *
+   * @param nodes The number of nodes of the synthetic scene.
+   * @param frames The number of simulated frames.
+   */
+   static void run(unsigned int nodes = 10000, unsigned int frames = 100);
+
+   /**
+   * @brief Benchmark the per-frame matrix work
+   *
+   * Compares plain glm against the MathKernels for world matrix composition, rigid inverse and
+   * normal matrix derivation on a synthetic hierarchy.
+   *
+   * @param nodes The number of nodes of the synthetic scene.
+   * @param frames The number of simulated frames.
+   */
+   static void matrices(unsigned int nodes = 10000, unsigned int frames = 100);
+
+   /**
+   * @brief Benchmark the parallel transform and bounds update
+   *
+   * Updates a synthetic scene made of independent subtrees with an increasing number of threads
+   * and checks that the result matches the serial update.
+   *
+   * @param nodes The number of nodes of the synthetic scene.
+   * @param frames The number of simulated frames.
+   */
+   static void hierarchy(unsigned int nodes = 100000, unsigned int frames = 100);
+
+   /**
+   * @brief Benchmark the frustum culling kernels
+   *
+   * Tests 1k, 10k and 100k random spheres with Frustum::sphereInFrustum() and with the batched
+   * SIMD kernel, reports the throughput in spheres per second and checks that the masks match.
+   *
+   * @param frames The number of simulated frames.
+   */
+   static void culling(unsigned int frames = 100);
+
+   /**
+   * @brief Benchmark the uniform location lookup
+   *
+   * Compares Shader::locate(), the lookup of the setters by name (a std::string built per call, then
+   * a std::map search), against the slot table of the uniform identifiers, for the modelview and normal
+   * matrix of every draw. Only the lookup is timed, on a program reflected without GL.
+   *
+   * @param draws The number of draws per frame.
+   * @param frames The number of simulated frames.
+   */
+   static void uniforms(unsigned int draws = 10000, unsigned int frames = 100);
+
+private:
+   /**
+   * @brief Print a timing line
+   *
+   * @param label The name of the measured task.
+   * @param reference The reference time, in milliseconds per frame.
+   * @param optimized The optimized time, in milliseconds per frame.
+   */
+   static void print(const char* label, double reference, double optimized);
+};
+
+#endif // BENCHMARK_H
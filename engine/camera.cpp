@@ -32,10 +32,27 @@ Eng::Camera::~Camera() {}
 /**
 * @brief Get the inverse camera matrix
 *
+* The camera transform is rigid (rotation + translation), so the cheap rigid
+* inverse is used and cached until the transform changes.
+*
 * @return The inverse of the camera's transformation matrix.
 */
 glm::mat4 ENG_API Eng::Camera::getInverseCameraMat() {
-    return glm::inverse(getTransform());
+    if (inverseDirty) {
+        inverseCameraMat = MathKernels::rigidInverse(getTransform());
+        inverseDirty = false;
+    }
+    return inverseCameraMat;
+}
+
+/**
+* @brief Notify that the camera transform changed
+*
+* Invalidates the cached inverse matrix.
+*/
+void Eng::Camera::transformChanged() {
+    Node::transformChanged();
+    inverseDirty = true;
 }
 
 /**
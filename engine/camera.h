@@ -35,7 +35,7 @@ public:
     *
     * @param name The name of the camera.
     */
-    Camera(const std::string& name) : Node(name) {};
+    Camera(const std::string& name) : Node(name, ObjectType::CAMERA) {};
 
     /**
     * @brief Destructor
@@ -75,6 +75,18 @@ public:
     * @param viewMatrix The transformation matrix to be set.
     */
     void setTransformCamera(glm::mat4 viewMatrix);
+
+protected:
+    /**
+    * @brief Notify that the camera transform changed
+    *
+    * Invalidates the cached inverse matrix.
+    */
+    void transformChanged() override;
+
+private:
+    glm::mat4 inverseCameraMat = glm::mat4(1.0f); /**< The cached inverse camera matrix */
+    bool inverseDirty = true; /**< True when the cached inverse is out of date */
 };
 
 #endif // CAMERA_H
\ No newline at end of file
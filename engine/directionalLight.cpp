@@ -34,21 +34,20 @@
 * @param specular The specular color of the light.
 */
 ENG_API Eng::DirectionalLight::DirectionalLight(const std::string name, const int lightNumber, const glm::vec4 ambient, const glm::vec4 diffuse, const glm::vec4 specular) :
-    Light{ name, lightNumber, ambient, diffuse, specular } {
+    Light{ name, lightNumber, ambient, diffuse, specular, ObjectType::LIGHT_DIRECTIONAL } {
    
 }
 
 /**
-* @brief Render the directional light
+* @brief Fill the uniform block of the light
 *
-* Renders the directional light using the given transformation matrix.
+* The position is a direction: w is 0.
 *
-* @param matrix The transformation matrix.
-* @param ptr A pointer to additional data.
-* @return True if the rendering was successful, false otherwise.
+* @param block The block to fill.
 */
-bool ENG_API Eng::DirectionalLight::render(glm::mat4 matrix, void* ptr) {
-    return true;
+void ENG_API Eng::DirectionalLight::getLightBlock(LightBlock& block) {
+    Light::getLightBlock(block);
+    block.position.w = 0.0f;
 }
 
 /**
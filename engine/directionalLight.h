@@ -48,15 +48,13 @@ public:
 	~DirectionalLight() {};
 
     /**
-    * @brief Render the directional light
+    * @brief Fill the uniform block of the light
     *
-    * Renders the directional light using the given transformation matrix.
+    * The position is a direction: w is 0.
     *
-    * @param matrix The transformation matrix.
-    * @param ptr A pointer to additional data.
-    * @return True if the rendering was successful, false otherwise.
+    * @param block The block to fill.
     */
-	bool render(glm::mat4 transform, void* data) override;
+	void getLightBlock(LightBlock& block) override;
 
     /**
     * @brief Set the transformation matrix for the directional light
@@ -187,8 +187,15 @@ void __stdcall DebugCallback(GLenum source, GLenum type, GLuint id, GLenum sever
 const char* vertShader = R"(
    #version 440 core
 
+   // Per-eye data (UniformBuffers::BINDING_FRAME):
+   layout(std140, binding = 0) uniform Frame
+   {
+      mat4 projection;
+      mat4 view;
+      vec4 eyePosition;
+   } frame;
+
    // Uniforms:
-   uniform mat4 projection;
    uniform mat4 modelview;
    uniform mat3 normalMatrix;
 
@@ -205,7 +212,7 @@ const char* vertShader = R"(
    void main(void)
    {
       fragPosition = modelview * vec4(in_Position, 1.0f);
-      gl_Position = projection * fragPosition;
+      gl_Position = frame.projection * fragPosition;
       normal = normalMatrix * in_Normal;
       texCoord = in_TexCoord;
    }
@@ -221,17 +228,33 @@ const char *pointFragShader = R"(
 
    out vec4 fragOutput;
 
-   // Material properties:
-   uniform vec3 matAmbient;
-   uniform vec3 matDiffuse;
-   uniform vec3 matSpecular;
-   uniform float matShininess;
+   // Per-eye data (UniformBuffers::BINDING_FRAME):
+   layout(std140, binding = 0) uniform Frame
+   {
+      mat4 projection;
+      mat4 view;
+      vec4 eyePosition;
+   } frame;
 
-   // Light properties:
-   uniform vec3 lightPosition;
-   uniform vec3 lightAmbient;
-   uniform vec3 lightDiffuse;
-   uniform vec3 lightSpecular;
+   // Light properties (UniformBuffers::BINDING_LIGHT), world space:
+   layout(std140, binding = 1) uniform Light
+   {
+      vec4 position;
+      vec4 direction;
+      vec4 ambient;
+      vec4 diffuse;
+      vec4 specular;
+      vec4 attenuation;
+   } light;
+
+   // Material properties (UniformBuffers::BINDING_MATERIAL), shininess in specular.w:
+   layout(std140, binding = 2) uniform Material
+   {
+      vec4 ambient;
+      vec4 diffuse;
+      vec4 specular;
+      vec4 emission;
+   } material;
 
    // Texture mapping:
    layout(binding = 0) uniform sampler2D texSampler;
@@ -242,20 +265,21 @@ const char *pointFragShader = R"(
       vec4 texel = texture(texSampler, texCoord);
 
       // Ambient term:
-      vec3 fragColor = matAmbient * lightAmbient;
+      vec3 fragColor = material.ambient.rgb * light.ambient.rgb;
 
-      // Diffuse term:
+      // Diffuse term (w = 0: directional light):
       vec3 _normal = normalize(normal);
-      vec3 lightDirection = normalize(lightPosition - fragPosition.xyz);
+      vec3 lightPosition = (frame.view * light.position).xyz;
+      vec3 lightDirection = normalize(light.position.w == 0.0f ? lightPosition : lightPosition - fragPosition.xyz);
       float nDotL = dot(lightDirection, _normal);
       if (nDotL > 0.0f)
       {
-         fragColor += matDiffuse * nDotL * lightDiffuse;
+         fragColor += material.diffuse.rgb * nDotL * light.diffuse.rgb;
 
          // Specular term:
          vec3 halfVector = normalize(lightDirection + normalize(-fragPosition.xyz));
          float nDotHV = dot(_normal, halfVector);
-         fragColor += matSpecular * pow(nDotHV, matShininess) * lightSpecular;
+         fragColor += material.specular.rgb * pow(nDotHV, material.specular.w) * light.specular.rgb;
       }
 
       // Final color:
@@ -321,6 +345,13 @@ bool ENG_API Eng::Base::init(int argc, char* argv[], const char* title)
            {
 
            }
+        // Engine side mirror of the GL state:
+        GlState::reset();
+
+        // Frame, light and material data shared by the shaders:
+        if (!UniformBuffers::init())
+           return false;
+
         #ifdef _DEBUG
            glDebugMessageCallback((GLDEBUGPROC)DebugCallback, nullptr);
            glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
@@ -376,8 +407,7 @@ bool ENG_API Eng::Base::init(int argc, char* argv[], const char* title)
         Shader::mapShader("lightShader", pointLightShader);
         Shader::getShader("lightShader")->render();
         
-        GLint prevViewport[4];
-        glGetIntegerv(GL_VIEWPORT, prevViewport);
+        const glm::ivec4 prevViewport = GlState::getViewport();
 
         if (renderMode == RenderMode::VR)
         {
@@ -388,7 +418,7 @@ bool ENG_API Eng::Base::init(int argc, char* argv[], const char* title)
         for (int c = 0; c < EYE_LAST; c++)
         {
            glGenTextures(1, &fboTexId[c]);
-           glBindTexture(GL_TEXTURE_2D, fboTexId[c]);
+           GlState::bindTexture(GL_TEXTURE_2D, fboTexId[c]);
 
            if (renderMode == RenderMode::VR) {
               glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, fboSizeX, fboSizeY, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
@@ -415,9 +445,12 @@ bool ENG_API Eng::Base::init(int argc, char* argv[], const char* title)
               std::cout << "[ERROR] Invalid FBO" << std::endl;
         }
         Fbo::disable();
-        glViewport(0, 0, prevViewport[2], prevViewport[3]);
+        GlState::viewport(0, 0, prevViewport.z, prevViewport.w);
     }
 
+    // Parallel update stage:
+    list.setUpdateThreads(std::thread::hardware_concurrency());
+
     // Done:
     std::cout << "[>] " << LIB_NAME << " initialized" << std::endl;
     reserved->initFlag = true;
@@ -442,6 +475,12 @@ bool ENG_API Eng::Base::free()
     // Close open connections or free allocated memory
     mainLoopRunning = false;
 
+    // Stop the update workers:
+    list.setUpdateThreads(0);
+
+    // Release the uniform buffers:
+    UniformBuffers::free();
+
     // Release bitmap and FreeImage:
     FreeImage_DeInitialise();
 
@@ -466,7 +505,7 @@ void ENG_API Eng::Base::reshapeCallback(int width, int height)
          glutReshapeWindow(APP_WINDOWSIZEX, APP_WINDOWSIZEY);
    }
    else {
-      glViewport(0, 0, width, height);
+      GlState::viewport(0, 0, width, height);
 
       perspective = glm::perspective(glm::radians(80.0f), (float)APP_FBOSIZEX / (float)APP_FBOSIZEY, 0.01f, 1000.0f);
       if (width != APP_WINDOWSIZEX || height != APP_WINDOWSIZEY)
@@ -479,9 +518,10 @@ void ENG_API Eng::Base::reshapeCallback(int width, int height)
  */
 void ENG_API Eng::Base::displayCallback()
 {
+   GlState::resetStats();
+   Shader::resetUniformStats();
    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-   GLint prevViewport[4];
-   glGetIntegerv(GL_VIEWPORT, prevViewport);
+   const glm::ivec4 prevViewport = GlState::getViewport();
    glm::mat4 headPos;
    if (renderMode == RenderMode::VR)
    {
@@ -492,10 +532,21 @@ void ENG_API Eng::Base::displayCallback()
    leap->update();
    const LEAP_TRACKING_EVENT* l = leap->getCurFrame();
 
+   // World matrices are computed once per frame and shared by both eyes:
+   list.updateWorldTransforms();
 
-   for (int c = 0; c < EYE_LAST; c++)
+   // Per-eye matrices:
+   glm::mat4 eyeProjection[EYE_LAST];
+   glm::mat4 eyeView[EYE_LAST];
+   glm::mat4 eyeViewProjection[EYE_LAST];
+   if (renderMode == RenderMode::VR)
    {
-      if (renderMode == RenderMode::VR)
+      glm::mat4 cameraOffset = glm::translate(glm::mat4(1.0f), glm::vec3(posxVr, posyVr, poszVr));
+      if (whitePosition)
+         cameraOffset = glm::rotate(cameraOffset, glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+      const glm::mat4 headView = MathKernels::rigidInverse(cameraOffset * headPos);
+
+      for (int c = 0; c < EYE_LAST; c++)
       {
          OvVR::OvEye curEye = (OvVR::OvEye)c;
          glm::mat4 projMat = ovr->getProjMatrix(curEye, 0.01f, 100.0f);
@@ -504,36 +555,65 @@ void ENG_API Eng::Base::displayCallback()
          glm::mat4 eye2Head = ovr->getEye2HeadMatrix(curEye);
 
          // Update camera projection matrix:
-         glm::mat4 ovrProjMat = projMat * glm::inverse(eye2Head);
-#ifdef APP_VERBOSE   
-         std::cout << "Eye " << c << " proj matrix: " << glm::to_string(ovrProjMat) << std::endl;
+         eyeProjection[c] = projMat * MathKernels::rigidInverse(eye2Head);
+         eyeView[c] = headView;
+      }
+   }
+   else
+   {
+      cameras.at(activeCamera)->setUserTransform(posxVr, posyVr, poszVr, 0.0f, 0.0f, 0.0f);
+      for (int c = 0; c < EYE_LAST; c++)
+      {
+         eyeProjection[c] = perspective;
+         eyeView[c] = cameras.at(activeCamera)->getTransform();
+      }
+   }
+   FrameBlock frames[EYE_LAST];
+   for (int c = 0; c < EYE_LAST; c++)
+   {
+      eyeViewProjection[c] = eyeProjection[c] * eyeView[c];
+      frames[c] = { eyeProjection[c], eyeView[c], MathKernels::rigidInverse(eyeView[c])[3] };
+   }
+
+   // Both eyes in one upload, each eye binds its own range:
+   UniformBuffers::setFrames(frames);
+
+   // Visibility is computed once per frame, for both eyes and all the light passes:
+   list.updateVisibility(eyeViewProjection, EYE_LAST);
+#ifdef APP_VERBOSE
+   std::cout << "Visible objects: " << list.getVisibleObjects().size() << ", occluded: " << list.getOccludedCount()
+      << ", small: " << list.getSmallCulledCount() << ", distant: " << list.getDistanceCulledCount() << std::endl;
 #endif
-         glm::mat4 cameraOffset = glm::translate(glm::mat4(1.0f), glm::vec3(posxVr, posyVr, poszVr));
-         if (whitePosition)
-            cameraOffset = glm::rotate(cameraOffset, glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 
-         glm::mat4 ovrModelViewMat = glm::inverse(cameraOffset * headPos); 
+   for (int c = 0; c < EYE_LAST; c++)
+   {
+      if (renderMode == RenderMode::VR)
+      {
+         OvVR::OvEye curEye = (OvVR::OvEye)c;
+         const glm::mat4& ovrProjMat = eyeProjection[c];
+         const glm::mat4& ovrModelViewMat = eyeView[c];
 #ifdef APP_VERBOSE   
+         std::cout << "Eye " << c << " proj matrix: " << glm::to_string(ovrProjMat) << std::endl;
          std::cout << "Eye " << c << " modelview matrix: " << glm::to_string(ovrModelViewMat) << std::endl;
 #endif
          fbo[c]->render();
          glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-         glEnable(GL_DEPTH_TEST);
-         glDepthFunc(GL_LEQUAL);
+         GlState::enable(GL_DEPTH_TEST);
+         GlState::depthFunc(GL_LEQUAL);
+         UniformBuffers::bindFrame(c);
 
          Shader::getShader("skyboxShader")->render();
-         Shader::getCurrentShader()->setMatrix("projection", ovrProjMat);
          glm::mat4 skyboxView = glm::mat4(glm::mat3(ovrModelViewMat));
          skybox->render(skyboxView, nullptr);
 
          Shader::getShader("lightShader")->render();
-         Shader::getCurrentShader()->setMatrix("projection", ovrProjMat);
 
          list.render(ovrModelViewMat, ovrProjMat, nullptr);
 
          Shader::getShader("leapShader")->render();
 
-         glm::mat4 viewMatrix = glm::inverse(cameraOffset * headPos);
+         // Same view matrix used for the scene:
+         const glm::mat4& viewMatrix = ovrModelViewMat;
 
          glm::mat4 leapToWorld = glm::mat4(1.0f);
          if (whitePosition) {
@@ -551,18 +631,19 @@ void ENG_API Eng::Base::displayCallback()
          leap->renderVRHandBones(l, leapModelViewMat, ovrProjMat, cameraMovement * leapToWorld);
          
          ovr->pass(curEye, fboTexId[c]);
+
+         // The compositor uses the context behind the engine:
+         GlState::invalidate();
       }
       else
       {
          fbo[c]->render();
          glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-         glEnable(GL_DEPTH_TEST);
-         glDepthFunc(GL_LEQUAL);
+         GlState::enable(GL_DEPTH_TEST);
+         GlState::depthFunc(GL_LEQUAL);
+         UniformBuffers::bindFrame(c);
 
-         cameras.at(activeCamera)->setUserTransform(posxVr, posyVr, poszVr, 0.0f, 0.0f, 0.0f);
-         
          Shader::getShader("skyboxShader")->render();
-         Shader::getCurrentShader()->setMatrix("projection", perspective);
          glm::mat4 skyboxView = glm::mat4(glm::mat3(cameras.at(activeCamera)->getInverseCameraMat()));
          skybox->render(skyboxView, nullptr);
 
@@ -571,24 +652,32 @@ void ENG_API Eng::Base::displayCallback()
          leap->renderNormalHandBones(l, cameras.at(activeCamera)->getInverseCameraMat(), perspective);
 
          Shader::getShader("lightShader")->render();
-         Shader::getCurrentShader()->setMatrix("projection", perspective);
 
-         list.render(cameras.at(activeCamera)->getTransform(), perspective, nullptr);
+         list.render(eyeView[c], eyeProjection[c], nullptr);
       } 
    }
 
+#ifdef APP_VERBOSE
+   const RenderStats& renderStats = list.getRenderStats();
+   std::cout << "Draws: " << renderStats.draws << ", texture binds saved: " << renderStats.textureBindsSaved
+      << ", material binds saved: " << renderStats.materialBindsSaved << ", VAO binds saved: " << renderStats.vaoBindsSaved << std::endl;
+   std::cout << "GL state calls: " << GlState::getStats().issued << " issued, " << GlState::getStats().skipped << " skipped" << std::endl;
+   std::cout << "Uniform sets: " << Shader::getUniformStats().misses << " uploaded, " << Shader::getUniformStats().hits << " skipped" << std::endl;
+#endif
+
    if (renderMode == RenderMode::VR)
    {
       ovr->render();
+      GlState::invalidate();
    }
 
    Fbo::disable();
-   glViewport(0, 0, prevViewport[2], prevViewport[3]);
+   GlState::viewport(0, 0, prevViewport.z, prevViewport.w);
 
-   glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo[0]->getHandle());
+   GlState::bindFramebuffer(GL_READ_FRAMEBUFFER, fbo[0]->getHandle());
    glBlitFramebuffer(0, 0, APP_FBOSIZEX, APP_FBOSIZEY, 0, 0, APP_FBOSIZEX, APP_FBOSIZEY, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 
-   glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo[1]->getHandle());
+   GlState::bindFramebuffer(GL_READ_FRAMEBUFFER, fbo[1]->getHandle());
    glBlitFramebuffer(0, 0, APP_FBOSIZEX, APP_FBOSIZEY, APP_FBOSIZEX, 0, APP_WINDOWSIZEX, APP_FBOSIZEY, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 }
 
@@ -603,16 +692,45 @@ void ENG_API Eng::Base::addCamera(Camera* camera) {
 /**
  * @brief Load a scene from a file.
  * @param pathName Path to the scene file.
- * @return A list of nodes representing the scene.
+ * @return A view of the nodes of the scene, valid until the next scene change.
  */
-std::list<Eng::Node*> ENG_API Eng::Base::loadScene(std::string pathName)
+std::span<Eng::Node* const> ENG_API Eng::Base::loadScene(std::string pathName)
 {
-    Node* root = reader.readFile(pathName.c_str());
-    list.addEntry(root);
-    leap->setPickableNodes(list.getPickableObjectsList());
+    SceneArena* arena = new SceneArena();
+    Node* root = reader.readFile(pathName.c_str(), arena);
+    if (root == nullptr) {
+        delete arena;
+        return list.getObjectList();
+    }
+    list.addEntry(root, arena);
+    leap->setPickGrid(&list.getPickGrid());
     return list.getObjectList(); 
 }
 
+/**
+ * @brief Attach a node (and its subtree) to a node of the scene.
+ * @param parent The new parent.
+ * @param node The node to attach.
+ */
+void ENG_API Eng::Base::addNode(Node* parent, Node* node)
+{
+    list.addEntry(parent, node);
+}
+
+/**
+ * @brief Remove a node (and its subtree) from the scene.
+ * @param node The node to remove.
+ * @return False if the node is not in the scene.
+ */
+bool ENG_API Eng::Base::removeNode(Node* node)
+{
+    node->visitDepthFirst([](Node* child) {
+        leap->releaseNode(child);
+        return Node::VisitResult::CONTINUE;
+    });
+    return list.removeEntry(node);
+}
+
 void ENG_API Eng::Base::loadSkybox(const std::string& face1, const std::string& face2, const std::string& face3,
    const std::string& face4, const std::string& face5, const std::string& face6) {
       if (skybox != nullptr) {
@@ -743,6 +861,73 @@ void Eng::Base::updateCameraPosition(float posx, float posy, float posz) {
    poszVr += posz;
 }
 
+/**
+ * @brief Enable or disable the flat transform storage.
+ * @param enable True to use the flat storage.
+ */
+void Eng::Base::setFlatTransforms(bool enable) {
+   list.setFlatTransforms(enable);
+}
+
+/**
+ * @brief Set the number of threads of the transform and bounds update stage.
+ * @param threads The number of threads, the render thread included (0 or 1 means serial).
+ */
+void Eng::Base::setUpdateThreads(unsigned int threads) {
+   list.setUpdateThreads(threads);
+}
+
+/**
+ * @brief Enable or disable the CPU occlusion culling.
+ * @param enable True to remove the objects hidden behind large static meshes.
+ */
+void Eng::Base::setOcclusionCulling(bool enable) {
+   list.setOcclusionCulling(enable);
+}
+
+/**
+ * @brief Get the number of objects rejected by the occlusion culling in the last frame.
+ * @return The number of occluded objects.
+ */
+unsigned int Eng::Base::getOccludedCount() const {
+   return list.getOccludedCount();
+}
+
+/**
+ * @brief Set the default small-feature and distance culling thresholds.
+ * @param minScreenSize The minimum projected diameter, as a fraction of the view height (0 disables).
+ * @param maxDrawDistance The maximum draw distance (0 disables).
+ */
+void Eng::Base::setDetailCulling(float minScreenSize, float maxDrawDistance) {
+   list.setDetailCulling(minScreenSize, maxDrawDistance);
+}
+
+/**
+ * @brief Get the number of objects skipped for their size or distance in the last frame.
+ * @return The number of small or distant objects skipped.
+ */
+unsigned int Eng::Base::getDetailCulledCount() const {
+   return list.getSmallCulledCount() + list.getDistanceCulledCount();
+}
+
+/**
+ * @brief Get the handle of a scene node by name.
+ * @param name The node name.
+ * @return The handle, null if no node has the name.
+ */
+Eng::NodeHandle Eng::Base::getNodeHandle(const std::string& name) const {
+   return list.getHandle(name);
+}
+
+/**
+ * @brief Resolve a scene node handle.
+ * @param handle The node handle.
+ * @return The node, nullptr if the handle is stale.
+ */
+Eng::Node* Eng::Base::getNode(NodeHandle handle) const {
+   return list.getObject(handle);
+}
+
 /**
  * @brief Change camera position for chessboard visualization.
 
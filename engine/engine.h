@@ -27,6 +27,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/packing.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/string_cast.hpp>
@@ -36,7 +37,20 @@
 #include <vector>
 #include <string>
 #include <list>
+#include <deque>
+#include <new>
 #include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <span>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cfloat>
+#include <bit>
 
 /////////////
 // VERSION //
@@ -77,7 +91,16 @@ namespace Eng {
 
        // You can subinclude here other headers of your engine...
 #include "object.h"
+#include "mathKernels.h"
+#include "glState.h"
+#include "uniformBuffers.h"
+#include "workerPool.h"
 #include "node.h"
+#include "transformStore.h"
+#include "nodeRegistry.h"
+#include "nodeSet.h"
+#include "pickGrid.h"
+#include "sceneArena.h"
 #include "leap.h"
 #include "skybox.h"
 #include "fbo.h"
@@ -93,9 +116,12 @@ namespace Eng {
 #include "pointLight.h"
 #include "spotLight.h"
 #include "frustum.h"
+#include "occlusionCuller.h"
+#include "renderQueue.h"
 #include "list.h"
 #include "LODData.h"
 #include "ovoReader.h"
+#include "benchmark.h"
 
 ///////////////////////
 // MAIN ENGINE CLASS //
@@ -267,9 +293,27 @@ namespace Eng {
          * Loads a scene from the specified file.
          *
          * @param sceneFile Path to the scene file.
-         * @return A list of nodes representing the scene.
+         * @return A view of the nodes of the scene, valid until the next scene change.
          */
-        std::list<Node*> loadScene(std::string sceneFile);
+        std::span<Node* const> loadScene(std::string sceneFile);
+
+        /**
+         * @brief Attach a node (and its subtree) to a node of the scene
+         *
+         * @param parent The new parent.
+         * @param node The node to attach.
+         */
+        void addNode(Node* parent, Node* node);
+
+        /**
+         * @brief Remove a node (and its subtree) from the scene
+         *
+         * The node is released by the hands and detached, but not deleted.
+         *
+         * @param node The node to remove.
+         * @return False if the node is not in the scene.
+         */
+        bool removeNode(Node* node);
 
         /**
          * @brief Set the active camera
@@ -323,6 +367,75 @@ namespace Eng {
          */
         void switchPosition();
 
+        /**
+         * @brief Enable or disable the flat transform storage
+         *
+         * Keeps the scene transforms in contiguous arrays sorted in topological order.
+         *
+         * @param enable True to use the flat storage.
+         */
+        void setFlatTransforms(bool enable);
+
+        /**
+         * @brief Set the number of threads of the transform and bounds update stage
+         *
+         * By default all the hardware threads are used.
+         *
+         * @param threads The number of threads, the render thread included (0 or 1 means serial).
+         */
+        void setUpdateThreads(unsigned int threads);
+
+        /**
+         * @brief Enable or disable the CPU occlusion culling
+         *
+         * Enabled by default.
+         *
+         * @param enable True to remove the objects hidden behind large static meshes.
+         */
+        void setOcclusionCulling(bool enable);
+
+        /**
+         * @brief Get the number of objects rejected by the occlusion culling in the last frame
+         *
+         * @return The number of occluded objects.
+         */
+        unsigned int getOccludedCount() const;
+
+        /**
+         * @brief Set the default small-feature and distance culling thresholds
+         *
+         * Disabled by default. Nodes can override them with Node::setDetailThresholds().
+         *
+         * @param minScreenSize The minimum projected diameter, as a fraction of the view height (0 disables).
+         * @param maxDrawDistance The maximum draw distance (0 disables).
+         */
+        void setDetailCulling(float minScreenSize, float maxDrawDistance);
+
+        /**
+         * @brief Get the number of objects skipped for their size or distance in the last frame
+         *
+         * @return The number of small or distant objects skipped.
+         */
+        unsigned int getDetailCulledCount() const;
+
+        /**
+         * @brief Get the handle of a scene node by name
+         *
+         * Resolve the handle every frame with getNode(): a stale handle resolves to nullptr.
+         *
+         * @param name The node name.
+         * @return The handle, null if no node has the name.
+         */
+        NodeHandle getNodeHandle(const std::string& name) const;
+
+        /**
+         * @brief Resolve a scene node handle
+         *
+         * @param handle The node handle.
+         * @return The node, nullptr if the handle is stale.
+         */
+        Node* getNode(NodeHandle handle) const;
+
     private: 
 
         // Reserved:
@@ -59,7 +59,7 @@ Eng::Fbo::~Fbo()
 	for (unsigned int c = 0; c < Fbo::MAX_ATTACHMENTS; c++)
 		if (glRenderBufferId[c])
 			glDeleteRenderbuffers(1, &glRenderBufferId[c]);
-	glDeleteFramebuffers(1, &glId);
+	GlState::deleteFramebuffer(glId);
 }
 
 Eng::Fbo* Eng::Fbo::getCurrentFbo()
@@ -166,7 +166,7 @@ bool Eng::Fbo::bindTexture(unsigned int textureNumber, unsigned int operation, u
 	this->texture[textureNumber] = texture;
 
 	// Get some texture information:
-	glBindTexture(GL_TEXTURE_2D, texture);
+	GlState::bindTexture(GL_TEXTURE_2D, texture);
 	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &sizeX);
 	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &sizeY);
 	return updateMrtCache();
@@ -262,7 +262,7 @@ bool Eng::Fbo::updateMrtCache()
  */
 void Eng::Fbo::disable()
 {
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	GlState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 
@@ -275,11 +275,11 @@ void Eng::Fbo::disable()
 bool Eng::Fbo::render(void* data)
 {
 	// Bind buffers:
-	glBindFramebuffer(GL_FRAMEBUFFER, glId);
+	GlState::bindFramebuffer(GL_FRAMEBUFFER, glId);
 	if (nrOfMrts)
 	{
 		glDrawBuffers(nrOfMrts, mrt);
-		glViewport(0, 0, sizeX, sizeY);
+		GlState::viewport(0, 0, sizeX, sizeY);
 	}
 	this->currentFbo = this;
 	// Done:   
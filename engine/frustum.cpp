@@ -37,6 +37,194 @@ bool Eng::Frustum::sphereInFrustum(const glm::vec3& center, float radius) const
    return true;
 }
 
+/**
+    * @brief Classifies an axis-aligned box against the frustum.
+    *
+    * @param min The minimum corner of the box.
+    * @param max The maximum corner of the box.
+    * @return OUTSIDE, INTERSECTING or INSIDE. An empty box (min > max) is OUTSIDE.
+    */
+Eng::FrustumTest Eng::Frustum::testBox(const glm::vec3& min, const glm::vec3& max) const {
+   if (min.x > max.x || min.y > max.y || min.z > max.z)
+      return FrustumTest::OUTSIDE;
+
+   const glm::vec3 center = (min + max) * 0.5f;
+   const glm::vec3 extent = (max - min) * 0.5f;
+   FrustumTest result = FrustumTest::INSIDE;
+   for (int i = 0; i < 6; ++i) {
+      // Projected radius of the box on the plane normal
+      const float radius = glm::dot(extent, glm::abs(planes[i].normal));
+      const float distance = planes[i].distance(center);
+      if (distance < -radius)
+         return FrustumTest::OUTSIDE;
+      if (distance < radius)
+         result = FrustumTest::INTERSECTING;
+   }
+   return result;
+}
+
+/**
+    * @brief Classifies an axis-aligned box against a subset of the planes.
+    *
+    * Only the planes in the mask are tested, starting from the plane that rejected the box last time.
+    * The planes the box is fully inside are removed from the mask, so the children of the box
+    * can skip them.
+    *
+    * @param min The minimum corner of the box.
+    * @param max The maximum corner of the box.
+    * @param planeMask The planes to test (bit i for plane i), updated.
+    * @param lastPlane The plane tested first, set to the rejecting plane.
+    * @return OUTSIDE, INTERSECTING or INSIDE (mask empty).
+    */
+Eng::FrustumTest Eng::Frustum::testBox(const glm::vec3& min, const glm::vec3& max, unsigned char& planeMask, unsigned char& lastPlane) const {
+   if (min.x > max.x || min.y > max.y || min.z > max.z)
+      return FrustumTest::OUTSIDE;
+
+   const glm::vec3 center = (min + max) * 0.5f;
+   const glm::vec3 extent = (max - min) * 0.5f;
+   for (int k = 0; k < 6; ++k) {
+      // Plane that rejected the box last time first, then the others in order
+      const int i = k == 0 ? lastPlane : (k <= lastPlane ? k - 1 : k);
+      if (!(planeMask & (1 << i)))
+         continue;
+
+      const float radius = glm::dot(extent, glm::abs(planes[i].normal));
+      const float distance = planes[i].distance(center);
+      if (distance < -radius) {
+         lastPlane = (unsigned char)i;
+         return FrustumTest::OUTSIDE;
+      }
+      if (distance >= radius)
+         planeMask &= (unsigned char)~(1 << i);
+   }
+   return planeMask == 0 ? FrustumTest::INSIDE : FrustumTest::INTERSECTING;
+}
+
+/**
+    * @brief Pushes all the planes outwards by a distance.
+    *
+    * @param margin The distance.
+    */
+void Eng::Frustum::expand(float margin) {
+   for (int i = 0; i < 6; ++i)
+      planes[i].d += margin;
+}
+
+/**
+    * @brief Checks if another frustum is inside this one, within a depth range.
+    *
+    * The other frustum is cut at the depth of the farthest corner of a box (the scene):
+    * what lies beyond can not contain any object.
+    *
+    * @param vpMatrix The View-Projection matrix of the other frustum.
+    * @param min The minimum corner of the box.
+    * @param max The maximum corner of the box.
+    * @return true if the cut frustum is fully inside.
+    */
+bool Eng::Frustum::containsFrustum(const glm::mat4& vpMatrix, const glm::vec3& min, const glm::vec3& max) const {
+   // Clip w is the depth along the view direction:
+   const glm::vec4 depthRow(vpMatrix[0][3], vpMatrix[1][3], vpMatrix[2][3], vpMatrix[3][3]);
+   float maxDepth = 0.0f;
+   for (int i = 0; i < 8; ++i) {
+      const glm::vec4 corner((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z, 1.0f);
+      maxDepth = std::max(maxDepth, glm::dot(depthRow, corner));
+   }
+
+   const glm::mat4 inverseVp = glm::inverse(vpMatrix);
+   for (int i = 0; i < 4; ++i) {
+      // Edge of the frustum from the near to the far plane:
+      const float x = (i & 1) ? 1.0f : -1.0f, y = (i & 2) ? 1.0f : -1.0f;
+      const glm::vec4 nearClip = inverseVp * glm::vec4(x, y, -1.0f, 1.0f);
+      const glm::vec4 farClip = inverseVp * glm::vec4(x, y, 1.0f, 1.0f);
+      const glm::vec3 nearCorner = glm::vec3(nearClip) / nearClip.w;
+      const glm::vec3 farCorner = glm::vec3(farClip) / farClip.w;
+
+      const float nearDepth = glm::dot(depthRow, glm::vec4(nearCorner, 1.0f));
+      const float farDepth = glm::dot(depthRow, glm::vec4(farCorner, 1.0f));
+      const float t = farDepth > nearDepth ? glm::clamp((maxDepth - nearDepth) / (farDepth - nearDepth), 0.0f, 1.0f) : 1.0f;
+      const glm::vec3 cutCorner = glm::mix(nearCorner, farCorner, t);
+
+      for (int p = 0; p < 6; ++p)
+         if (planes[p].distance(nearCorner) < 0.0f || planes[p].distance(cutCorner) < 0.0f)
+            return false;
+   }
+   return true;
+}
+
+/**
+    * @brief Checks if an oriented box is inside or intersects the frustum.
+    *
+    * The box is a local-space AABB moved by a world matrix, so it stays tight for
+    * rotated, flat or elongated meshes.
+    *
+    * @param world The world matrix of the box.
+    * @param min The minimum corner in local space.
+    * @param max The maximum corner in local space.
+    * @return true if the box is inside or intersects the frustum, false otherwise.
+    */
+bool Eng::Frustum::orientedBoxInFrustum(const glm::mat4& world, const glm::vec3& min, const glm::vec3& max) const {
+   const glm::vec3 center = glm::vec3(world * glm::vec4((min + max) * 0.5f, 1.0f));
+   const glm::vec3 half = (max - min) * 0.5f;
+   const glm::vec3 axisX = glm::vec3(world[0]) * half.x;
+   const glm::vec3 axisY = glm::vec3(world[1]) * half.y;
+   const glm::vec3 axisZ = glm::vec3(world[2]) * half.z;
+
+   for (int i = 0; i < 6; ++i) {
+      // Projected radius of the box on the plane normal
+      const float radius = std::abs(glm::dot(planes[i].normal, axisX))
+         + std::abs(glm::dot(planes[i].normal, axisY))
+         + std::abs(glm::dot(planes[i].normal, axisZ));
+      if (planes[i].distance(center) < -radius)
+         return false; // Totalmente fuori
+   }
+   return true;
+}
+
+/**
+    * @brief Tests a batch of spheres with the SIMD kernel.
+    *
+    * Same result as sphereInFrustum() on every sphere.
+    *
+    * @param spheres The spheres.
+    * @param mask The visibility bitmask, resized to one bit per sphere (bit i % 32 of word i / 32).
+    */
+void Eng::Frustum::testSpheres(const SphereArrays& spheres, std::vector<unsigned int>& mask) const {
+   glm::vec4 packed[6];
+   for (int i = 0; i < 6; ++i)
+      packed[i] = glm::vec4(planes[i].normal, planes[i].d);
+
+   const unsigned int count = spheres.size();
+   mask.resize((count + 31) / 32);
+   MathKernels::spheresInPlanes(packed, spheres.x.data(), spheres.y.data(), spheres.z.data(),
+      spheres.radius.data(), count, mask.data());
+}
+
+/**
+    * @brief Pushes the planes outwards until another frustum is fully inside.
+    *
+    * The result is a conservative convex bound of the union of the two frusta
+    * (e.g. the two eyes of a stereo pair).
+    *
+    * @param vpMatrix The View-Projection matrix of the other frustum.
+    */
+void Eng::Frustum::expandToContain(const glm::mat4& vpMatrix) {
+   // World space corners of the other frustum:
+   const glm::mat4 inverseVp = glm::inverse(vpMatrix);
+   glm::vec3 corners[8];
+   for (int i = 0; i < 8; ++i) {
+      const glm::vec4 ndc((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+      const glm::vec4 corner = inverseVp * ndc;
+      corners[i] = glm::vec3(corner) / corner.w;
+   }
+
+   for (int p = 0; p < 6; ++p) {
+      float minDistance = 0.0f;
+      for (int i = 0; i < 8; ++i)
+         minDistance = std::min(minDistance, planes[p].distance(corners[i]));
+      planes[p].d -= minDistance;
+   }
+}
+
 /**
  * @brief Extracts the six frustum planes from a ViewProjection matrix.
  *
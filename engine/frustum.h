@@ -26,6 +26,55 @@ struct FrustumPlane {
    float distance(const glm::vec3& point) const;
 };
 
+/**
+ * @brief Result of a bounding volume test against the frustum.
+ */
+enum class FrustumTest {
+   OUTSIDE,     ///< Fully outside
+   INTERSECTING,///< Crosses at least one plane
+   INSIDE       ///< Fully inside
+};
+
+/**
+ * @brief Bounding spheres packed as structure of arrays, the input of the batched frustum test.
+ */
+struct SphereArrays {
+   std::vector<float> x;      /**< Center x coordinates */
+   std::vector<float> y;      /**< Center y coordinates */
+   std::vector<float> z;      /**< Center z coordinates */
+   std::vector<float> radius; /**< Radii */
+
+   /**
+    * @brief Appends a sphere.
+    *
+    * @param center The sphere center.
+    * @param r The sphere radius.
+    */
+   void push(const glm::vec3& center, float r) {
+      x.push_back(center.x);
+      y.push_back(center.y);
+      z.push_back(center.z);
+      radius.push_back(r);
+   }
+
+   /**
+    * @brief Removes all the spheres, the capacity is kept.
+    */
+   void clear() {
+      x.clear();
+      y.clear();
+      z.clear();
+      radius.clear();
+   }
+
+   /**
+    * @brief Gets the number of spheres.
+    *
+    * @return The number of spheres.
+    */
+   unsigned int size() const { return (unsigned int)x.size(); }
+};
+
 /**
  * @brief Represents a view frustum defined by six planes.
  */
@@ -40,6 +89,83 @@ struct Frustum {
     * @return true if the sphere is inside or intersects the frustum, false otherwise.
     */
    bool sphereInFrustum(const glm::vec3& center, float radius) const;
+
+   /**
+    * @brief Classifies an axis-aligned box against the frustum.
+    *
+    * @param min The minimum corner of the box.
+    * @param max The maximum corner of the box.
+    * @return OUTSIDE, INTERSECTING or INSIDE. An empty box (min > max) is OUTSIDE.
+    */
+   FrustumTest testBox(const glm::vec3& min, const glm::vec3& max) const;
+
+   /**
+    * @brief Classifies an axis-aligned box against a subset of the planes.
+    *
+    * Only the planes in the mask are tested, starting from the plane that rejected the box last time.
+    * The planes the box is fully inside are removed from the mask, so the children of the box
+    * can skip them.
+    *
+    * @param min The minimum corner of the box.
+    * @param max The maximum corner of the box.
+    * @param planeMask The planes to test (bit i for plane i), updated.
+    * @param lastPlane The plane tested first, set to the rejecting plane.
+    * @return OUTSIDE, INTERSECTING or INSIDE (mask empty).
+    */
+   FrustumTest testBox(const glm::vec3& min, const glm::vec3& max, unsigned char& planeMask, unsigned char& lastPlane) const;
+
+   /**
+    * @brief Pushes all the planes outwards by a distance.
+    *
+    * @param margin The distance.
+    */
+   void expand(float margin);
+
+   /**
+    * @brief Checks if another frustum is inside this one, within a depth range.
+    *
+    * The other frustum is cut at the depth of the farthest corner of a box (the scene):
+    * what lies beyond can not contain any object.
+    *
+    * @param vpMatrix The View-Projection matrix of the other frustum.
+    * @param min The minimum corner of the box.
+    * @param max The maximum corner of the box.
+    * @return true if the cut frustum is fully inside.
+    */
+   bool containsFrustum(const glm::mat4& vpMatrix, const glm::vec3& min, const glm::vec3& max) const;
+
+   /**
+    * @brief Checks if an oriented box is inside or intersects the frustum.
+    *
+    * The box is a local-space AABB moved by a world matrix, so it stays tight for
+    * rotated, flat or elongated meshes.
+    *
+    * @param world The world matrix of the box.
+    * @param min The minimum corner in local space.
+    * @param max The maximum corner in local space.
+    * @return true if the box is inside or intersects the frustum, false otherwise.
+    */
+   bool orientedBoxInFrustum(const glm::mat4& world, const glm::vec3& min, const glm::vec3& max) const;
+
+   /**
+    * @brief Tests a batch of spheres with the SIMD kernel.
+    *
+    * Same result as sphereInFrustum() on every sphere.
+    *
+    * @param spheres The spheres.
+    * @param mask The visibility bitmask, resized to one bit per sphere (bit i % 32 of word i / 32).
+    */
+   void testSpheres(const SphereArrays& spheres, std::vector<unsigned int>& mask) const;
+
+   /**
+    * @brief Pushes the planes outwards until another frustum is fully inside.
+    *
+    * The result is a conservative convex bound of the union of the two frusta
+    * (e.g. the two eyes of a stereo pair).
+    *
+    * @param vpMatrix The View-Projection matrix of the other frustum.
+    */
+   void expandToContain(const glm::mat4& vpMatrix);
 };
 
 /**
@@ -0,0 +1,549 @@
+/**
+* @file glState.cpp
+* @brief Implementation of the GlState class
+*
+* This file contains the implementation of the GlState class methods.
+*
+* @see GlState
+* @see glState.h
+*
+* @date 2025
+*
+* @details An unknown entry of the shadow (after invalidate()) never matches, so the next call is issued.
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+#include <GL/glew.h>
+#include "engine.h"
+
+/////////////
+// #STATIC //
+/////////////
+
+static const unsigned int unknown = 0xFFFFFFFFu; /**< Value of a shadow entry not known */
+static const unsigned int maxUnits = 16; /**< Tracked texture units */
+static const unsigned int maxUniformBindings = 8; /**< Tracked uniform block binding points */
+static const unsigned int trackedTargets[] = { GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP }; /**< Tracked texture targets */
+static const unsigned int trackedCapabilities[] = { GL_DEPTH_TEST, GL_BLEND, GL_SCISSOR_TEST, GL_CULL_FACE }; /**< Tracked capabilities */
+
+/**
+* @brief The mirrored state
+*/
+static struct {
+   unsigned int program = unknown; /**< Bound program */
+   unsigned int vao = unknown; /**< Bound VAO */
+   unsigned int activeUnit = unknown; /**< Active texture unit */
+   unsigned int textures[maxUnits][2]; /**< Bound textures, per unit and tracked target */
+   unsigned int drawFramebuffer = unknown; /**< Bound draw framebuffer */
+   unsigned int readFramebuffer = unknown; /**< Bound read framebuffer */
+   glm::uvec3 uniformRanges[maxUniformBindings]; /**< Bound uniform buffer ranges: buffer, offset and size */
+   glm::ivec4 viewport = glm::ivec4(0); /**< The viewport */
+   bool viewportKnown = false; /**< True if the viewport is mirrored */
+   glm::ivec4 scissorBox = glm::ivec4(0); /**< The scissor box */
+   bool scissorKnown = false; /**< True if the scissor box is mirrored */
+   unsigned int capabilities[4] = { unknown, unknown, unknown, unknown }; /**< Tracked capabilities, 1 if enabled */
+   unsigned int depthFunc = unknown; /**< The depth function */
+   unsigned int blendSource = unknown; /**< The source blend factor */
+   unsigned int blendDestination = unknown; /**< The destination blend factor */
+} shadow;
+
+// Validation from the start, e.g. in the debug builds:
+#ifdef ENG_GLSTATE_VALIDATE
+static bool validation = true; /**< Validation mode flag */
+#else
+static bool validation = false; /**< Validation mode flag */
+#endif
+static Eng::GlStateStats stats; /**< Call counters */
+
+/**
+* @brief Get the index of a tracked texture target
+*
+* @param target The texture target.
+* @return The index, -1 if the target is not tracked.
+*/
+static int targetIndex(unsigned int target) {
+   for (int i = 0; i < 2; i++)
+      if (trackedTargets[i] == target)
+         return i;
+   return -1;
+}
+
+/**
+* @brief Get the index of a tracked capability
+*
+* @param capability The capability.
+* @return The index, -1 if the capability is not tracked.
+*/
+static int capabilityIndex(unsigned int capability) {
+   for (int i = 0; i < 4; i++)
+      if (trackedCapabilities[i] == capability)
+         return i;
+   return -1;
+}
+
+/**
+* @brief Count a call and validate the shadow when requested
+*
+* @param forwarded True if the call reached OpenGL.
+*/
+static void count(bool forwarded) {
+   if (forwarded)
+      stats.issued++;
+   else
+      stats.skipped++;
+   if (validation)
+      Eng::GlState::validate();
+}
+
+/**
+* @brief Compare a shadow entry with the real state
+*
+* @param name The state name, for the report.
+* @param real The value read from OpenGL.
+* @param mirrored The shadow value.
+* @return True if they match or the entry is not known.
+*/
+static bool check(const char* name, unsigned int real, unsigned int mirrored) {
+   if (mirrored == unknown || real == mirrored)
+      return true;
+   std::cout << "[ERROR] GlState: " << name << " is " << real << ", shadow " << mirrored << std::endl;
+   return false;
+}
+
+/**
+* @brief Load the default state of a new context
+*
+* Called once after the context creation. The viewport is read back here, once.
+*/
+void ENG_API Eng::GlState::reset() {
+   invalidate();
+   shadow.program = 0;
+   shadow.vao = 0;
+   shadow.activeUnit = 0;
+   for (auto& unit : shadow.textures)
+      unit[0] = unit[1] = 0;
+   shadow.drawFramebuffer = shadow.readFramebuffer = 0;
+   for (glm::uvec3& range : shadow.uniformRanges)
+      range = glm::uvec3(0);
+   for (unsigned int& capability : shadow.capabilities)
+      capability = 0;
+   shadow.depthFunc = GL_LESS;
+   shadow.blendSource = GL_ONE;
+   shadow.blendDestination = GL_ZERO;
+
+   // The default scissor box is the initial viewport:
+   getViewport();
+   shadow.scissorBox = shadow.viewport;
+   shadow.scissorKnown = true;
+}
+
+/**
+* @brief Forget the shadow
+*
+* The next call of every kind is issued. Use after code that changes the state behind the engine.
+*/
+void ENG_API Eng::GlState::invalidate() {
+   shadow.program = unknown;
+   shadow.vao = unknown;
+   shadow.activeUnit = unknown;
+   for (auto& unit : shadow.textures)
+      unit[0] = unit[1] = unknown;
+   shadow.drawFramebuffer = shadow.readFramebuffer = unknown;
+   for (glm::uvec3& range : shadow.uniformRanges)
+      range = glm::uvec3(unknown);
+   shadow.viewportKnown = false;
+   shadow.scissorKnown = false;
+   for (unsigned int& capability : shadow.capabilities)
+      capability = unknown;
+   shadow.depthFunc = unknown;
+   shadow.blendSource = shadow.blendDestination = unknown;
+}
+
+/**
+* @brief Bind a program
+*
+* @param program The program, 0 for none.
+*/
+void ENG_API Eng::GlState::useProgram(unsigned int program) {
+   const bool change = shadow.program != program;
+   if (change) {
+      glUseProgram(program);
+      shadow.program = program;
+   }
+   count(change);
+}
+
+/**
+* @brief Delete a program, forgetting it if bound
+*
+* @param program The program.
+*/
+void ENG_API Eng::GlState::deleteProgram(unsigned int program) {
+   glDeleteProgram(program);
+
+   // A bound program stays in use until unbound: the next bind must be issued
+   if (shadow.program == program)
+      shadow.program = unknown;
+}
+
+/**
+* @brief Bind a vertex array object
+*
+* @param vao The VAO, 0 for none.
+*/
+void ENG_API Eng::GlState::bindVertexArray(unsigned int vao) {
+   const bool change = shadow.vao != vao;
+   if (change) {
+      glBindVertexArray(vao);
+      shadow.vao = vao;
+   }
+   count(change);
+}
+
+/**
+* @brief Delete a vertex array object, forgetting it if bound
+*
+* Deleting the bound VAO binds 0.
+*
+* @param vao The VAO.
+*/
+void ENG_API Eng::GlState::deleteVertexArray(unsigned int vao) {
+   glDeleteVertexArrays(1, &vao);
+   if (shadow.vao == vao)
+      shadow.vao = 0;
+}
+
+/**
+* @brief Select the active texture unit
+*
+* @param unit The unit index (not the GL_TEXTURE0 enum).
+*/
+void ENG_API Eng::GlState::activeTexture(unsigned int unit) {
+   const bool change = shadow.activeUnit != unit;
+   if (change) {
+      glActiveTexture(GL_TEXTURE0 + unit);
+      shadow.activeUnit = unit;
+   }
+   count(change);
+}
+
+/**
+* @brief Bind a texture to the active unit
+*
+* GL_TEXTURE_2D and GL_TEXTURE_CUBE_MAP are tracked, the other targets are always issued.
+*
+* @param target The texture target.
+* @param texture The texture, 0 for none.
+*/
+void ENG_API Eng::GlState::bindTexture(unsigned int target, unsigned int texture) {
+   const int index = targetIndex(target);
+   const bool tracked = index >= 0 && shadow.activeUnit < maxUnits;
+   const bool change = !tracked || shadow.textures[shadow.activeUnit][index] != texture;
+   if (change) {
+      glBindTexture(target, texture);
+      if (tracked)
+         shadow.textures[shadow.activeUnit][index] = texture;
+   }
+   count(change);
+}
+
+/**
+* @brief Delete a texture, forgetting it on every unit it is bound to
+*
+* Deleting a bound texture binds 0 to its target, on every unit. The name can be reused by the
+* next glGenTextures().
+*
+* @param texture The texture.
+*/
+void ENG_API Eng::GlState::deleteTexture(unsigned int texture) {
+   glDeleteTextures(1, &texture);
+   for (auto& unit : shadow.textures)
+      for (unsigned int& bound : unit)
+         if (bound == texture)
+            bound = 0;
+}
+
+/**
+* @brief Bind a framebuffer
+*
+* @param target GL_FRAMEBUFFER (draw and read), GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER.
+* @param framebuffer The framebuffer, 0 for the window.
+*/
+void ENG_API Eng::GlState::bindFramebuffer(unsigned int target, unsigned int framebuffer) {
+   const bool draw = target != GL_READ_FRAMEBUFFER;
+   const bool read = target != GL_DRAW_FRAMEBUFFER;
+   const bool change = (draw && shadow.drawFramebuffer != framebuffer) || (read && shadow.readFramebuffer != framebuffer);
+   if (change) {
+      glBindFramebuffer(target, framebuffer);
+      if (draw)
+         shadow.drawFramebuffer = framebuffer;
+      if (read)
+         shadow.readFramebuffer = framebuffer;
+   }
+   count(change);
+}
+
+/**
+* @brief Delete a framebuffer, forgetting it if bound
+*
+* Deleting a bound framebuffer binds the window.
+*
+* @param framebuffer The framebuffer.
+*/
+void ENG_API Eng::GlState::deleteFramebuffer(unsigned int framebuffer) {
+   glDeleteFramebuffers(1, &framebuffer);
+   if (shadow.drawFramebuffer == framebuffer)
+      shadow.drawFramebuffer = 0;
+   if (shadow.readFramebuffer == framebuffer)
+      shadow.readFramebuffer = 0;
+}
+
+/**
+* @brief Bind a range of a buffer to a uniform block binding point
+*
+* The first bindings are tracked, the others are always issued.
+*
+* @param index The binding point.
+* @param buffer The buffer.
+* @param offset The start of the range, a multiple of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+* @param size The size of the range.
+*/
+void ENG_API Eng::GlState::bindUniformRange(unsigned int index, unsigned int buffer, unsigned int offset, unsigned int size) {
+   const glm::uvec3 range(buffer, offset, size);
+   const bool tracked = index < maxUniformBindings;
+   const bool change = !tracked || shadow.uniformRanges[index] != range;
+   if (change) {
+      glBindBufferRange(GL_UNIFORM_BUFFER, index, buffer, offset, size);
+      if (tracked)
+         shadow.uniformRanges[index] = range;
+   }
+   count(change);
+}
+
+/**
+* @brief Delete a buffer, forgetting the ranges bound from it
+*
+* Deleting a bound buffer unbinds it.
+*
+* @param buffer The buffer.
+*/
+void ENG_API Eng::GlState::deleteBuffer(unsigned int buffer) {
+   glDeleteBuffers(1, &buffer);
+   for (glm::uvec3& range : shadow.uniformRanges)
+      if (range.x == buffer)
+         range = glm::uvec3(0);
+}
+
+/**
+* @brief Set the viewport
+*
+* @param x The left edge.
+* @param y The bottom edge.
+* @param width The width.
+* @param height The height.
+*/
+void ENG_API Eng::GlState::viewport(int x, int y, int width, int height) {
+   const glm::ivec4 value(x, y, width, height);
+   const bool change = !shadow.viewportKnown || shadow.viewport != value;
+   if (change) {
+      glViewport(x, y, width, height);
+      shadow.viewport = value;
+      shadow.viewportKnown = true;
+   }
+   count(change);
+}
+
+/**
+* @brief Get the viewport
+*
+* Read from the shadow. The driver is only queried if the viewport is not known
+* (before reset() or after invalidate()).
+*
+* @return The viewport: x, y, width and height.
+*/
+const glm::ivec4 ENG_API& Eng::GlState::getViewport() {
+   if (!shadow.viewportKnown) {
+      glGetIntegerv(GL_VIEWPORT, &shadow.viewport.x);
+      shadow.viewportKnown = true;
+   }
+   return shadow.viewport;
+}
+
+/**
+* @brief Set the scissor box
+*
+* @param x The left edge.
+* @param y The bottom edge.
+* @param width The width.
+* @param height The height.
+*/
+void ENG_API Eng::GlState::scissor(int x, int y, int width, int height) {
+   const glm::ivec4 value(x, y, width, height);
+   const bool change = !shadow.scissorKnown || shadow.scissorBox != value;
+   if (change) {
+      glScissor(x, y, width, height);
+      shadow.scissorBox = value;
+      shadow.scissorKnown = true;
+   }
+   count(change);
+}
+
+/**
+* @brief Enable a capability
+*
+* GL_DEPTH_TEST, GL_BLEND, GL_SCISSOR_TEST and GL_CULL_FACE are tracked, the others are always issued.
+*
+* @param capability The capability.
+*/
+void ENG_API Eng::GlState::enable(unsigned int capability) {
+   const int index = capabilityIndex(capability);
+   const bool change = index < 0 || shadow.capabilities[index] != 1;
+   if (change) {
+      glEnable(capability);
+      if (index >= 0)
+         shadow.capabilities[index] = 1;
+   }
+   count(change);
+}
+
+/**
+* @brief Disable a capability
+*
+* @param capability The capability.
+*/
+void ENG_API Eng::GlState::disable(unsigned int capability) {
+   const int index = capabilityIndex(capability);
+   const bool change = index < 0 || shadow.capabilities[index] != 0;
+   if (change) {
+      glDisable(capability);
+      if (index >= 0)
+         shadow.capabilities[index] = 0;
+   }
+   count(change);
+}
+
+/**
+* @brief Set the depth comparison
+*
+* @param func The depth function.
+*/
+void ENG_API Eng::GlState::depthFunc(unsigned int func) {
+   const bool change = shadow.depthFunc != func;
+   if (change) {
+      glDepthFunc(func);
+      shadow.depthFunc = func;
+   }
+   count(change);
+}
+
+/**
+* @brief Set the blend factors
+*
+* @param source The source factor.
+* @param destination The destination factor.
+*/
+void ENG_API Eng::GlState::blendFunc(unsigned int source, unsigned int destination) {
+   const bool change = shadow.blendSource != source || shadow.blendDestination != destination;
+   if (change) {
+      glBlendFunc(source, destination);
+      shadow.blendSource = source;
+      shadow.blendDestination = destination;
+   }
+   count(change);
+}
+
+/**
+* @brief Enable or disable the validation mode
+*
+* @param enable True to validate.
+*/
+void ENG_API Eng::GlState::setValidation(bool enable) {
+   validation = enable;
+}
+
+/**
+* @brief Compare the shadow with the real state
+*
+* Only the active texture unit is checked: the others can't be read without changing it.
+*
+* @return True if the shadow matches.
+*/
+bool ENG_API Eng::GlState::validate() {
+   GLint value;
+   bool valid = true;
+
+   glGetIntegerv(GL_CURRENT_PROGRAM, &value);
+   valid &= check("program", value, shadow.program);
+   glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &value);
+   valid &= check("VAO", value, shadow.vao);
+   glGetIntegerv(GL_ACTIVE_TEXTURE, &value);
+   valid &= check("active texture unit", value - GL_TEXTURE0, shadow.activeUnit);
+   if (shadow.activeUnit < maxUnits) {
+      glGetIntegerv(GL_TEXTURE_BINDING_2D, &value);
+      valid &= check("2D texture", value, shadow.textures[shadow.activeUnit][0]);
+      glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &value);
+      valid &= check("cube map", value, shadow.textures[shadow.activeUnit][1]);
+   }
+   glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &value);
+   valid &= check("draw framebuffer", value, shadow.drawFramebuffer);
+   glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &value);
+   valid &= check("read framebuffer", value, shadow.readFramebuffer);
+   for (unsigned int i = 0; i < maxUniformBindings; i++) {
+      const glm::uvec3& range = shadow.uniformRanges[i];
+      glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, i, &value);
+      valid &= check("uniform buffer", value, range.x);
+      if (range.x == unknown || range.x == 0)
+         continue;
+      glGetIntegeri_v(GL_UNIFORM_BUFFER_START, i, &value);
+      valid &= check("uniform buffer offset", value, range.y);
+      glGetIntegeri_v(GL_UNIFORM_BUFFER_SIZE, i, &value);
+      valid &= check("uniform buffer size", value, range.z);
+   }
+
+   glm::ivec4 box;
+   if (shadow.viewportKnown) {
+      glGetIntegerv(GL_VIEWPORT, &box.x);
+      if (box != shadow.viewport) {
+         std::cout << "[ERROR] GlState: viewport is " << glm::to_string(box) << ", shadow " << glm::to_string(shadow.viewport) << std::endl;
+         valid = false;
+      }
+   }
+   if (shadow.scissorKnown) {
+      glGetIntegerv(GL_SCISSOR_BOX, &box.x);
+      if (box != shadow.scissorBox) {
+         std::cout << "[ERROR] GlState: scissor box is " << glm::to_string(box) << ", shadow " << glm::to_string(shadow.scissorBox) << std::endl;
+         valid = false;
+      }
+   }
+
+   static const char* capabilityNames[] = { "depth test", "blend", "scissor test", "face culling" };
+   for (int i = 0; i < 4; i++)
+      valid &= check(capabilityNames[i], glIsEnabled(trackedCapabilities[i]) ? 1 : 0, shadow.capabilities[i]);
+   glGetIntegerv(GL_DEPTH_FUNC, &value);
+   valid &= check("depth function", value, shadow.depthFunc);
+   glGetIntegerv(GL_BLEND_SRC_RGB, &value);
+   valid &= check("blend source", value, shadow.blendSource);
+   glGetIntegerv(GL_BLEND_DST_RGB, &value);
+   valid &= check("blend destination", value, shadow.blendDestination);
+   return valid;
+}
+
+/**
+* @brief Get the call counters
+*
+* @return The calls issued and skipped since the last resetStats().
+*/
+const Eng::GlStateStats ENG_API& Eng::GlState::getStats() {
+   return stats;
+}
+
+/**
+* @brief Reset the call counters
+*/
+void ENG_API Eng::GlState::resetStats() {
+   stats = GlStateStats();
+}
@@ -0,0 +1,237 @@
+/**
+* @file glState.h
+* @brief GlState class header file
+*
+* This file contains the definition of the GlState class, the shadow of the OpenGL state that
+* skips the calls which would not change anything.
+*
+* @date 2025
+*
+* @details The bound program, VAO, textures (per unit and target), framebuffers, uniform buffer ranges,
+* viewport, scissor box, depth and blend state are mirrored on the CPU. Every engine bind goes through this class, so the
+* shadow stays exact and the viewport never has to be read back from the driver. Code outside the
+* engine that touches the state (e.g. the VR compositor) must be followed by invalidate().
+* The validation mode compares the shadow with the real state after every call: enabled with
+* setValidation() or, from the start, by building with ENG_GLSTATE_VALIDATE.
+* @see Eng::Shader, Eng::Fbo, Eng::Mesh
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+
+#ifndef GL_STATE_H
+#define GL_STATE_H
+
+#include "engine.h"
+
+/**
+* @brief Calls issued to the driver and calls skipped by GlState
+*/
+struct ENG_API GlStateStats {
+   unsigned int issued = 0; /**< Calls forwarded to OpenGL */
+   unsigned int skipped = 0; /**< Calls that would not have changed the state */
+};
+
+/**
+* @brief GlState class
+*
+* Static shadow of the OpenGL state of the engine context.
+*/
+class ENG_API GlState {
+public:
+   /**
+   * @brief Load the default state of a new context
+   *
+   * Called once after the context creation. The viewport is read back here, once.
+   */
+   static void reset();
+
+   /**
+   * @brief Forget the shadow
+   *
+   * The next call of every kind is issued. Use after code that changes the state behind the engine.
+   */
+   static void invalidate();
+
+   /**
+   * @brief Bind a program
+   *
+   * @param program The program, 0 for none.
+   */
+   static void useProgram(unsigned int program);
+
+   /**
+   * @brief Delete a program, forgetting it if bound
+   *
+   * @param program The program.
+   */
+   static void deleteProgram(unsigned int program);
+
+   /**
+   * @brief Bind a vertex array object
+   *
+   * @param vao The VAO, 0 for none.
+   */
+   static void bindVertexArray(unsigned int vao);
+
+   /**
+   * @brief Delete a vertex array object, forgetting it if bound
+   *
+   * @param vao The VAO.
+   */
+   static void deleteVertexArray(unsigned int vao);
+
+   /**
+   * @brief Select the active texture unit
+   *
+   * @param unit The unit index (not the GL_TEXTURE0 enum).
+   */
+   static void activeTexture(unsigned int unit);
+
+   /**
+   * @brief Bind a texture to the active unit
+   *
+   * GL_TEXTURE_2D and GL_TEXTURE_CUBE_MAP are tracked, the other targets are always issued.
+   *
+   * @param target The texture target.
+   * @param texture The texture, 0 for none.
+   */
+   static void bindTexture(unsigned int target, unsigned int texture);
+
+   /**
+   * @brief Delete a texture, forgetting it on every unit it is bound to
+   *
+   * @param texture The texture.
+   */
+   static void deleteTexture(unsigned int texture);
+
+   /**
+   * @brief Bind a framebuffer
+   *
+   * @param target GL_FRAMEBUFFER (draw and read), GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER.
+   * @param framebuffer The framebuffer, 0 for the window.
+   */
+   static void bindFramebuffer(unsigned int target, unsigned int framebuffer);
+
+   /**
+   * @brief Delete a framebuffer, forgetting it if bound
+   *
+   * @param framebuffer The framebuffer.
+   */
+   static void deleteFramebuffer(unsigned int framebuffer);
+
+   /**
+   * @brief Bind a range of a buffer to a uniform block binding point
+   *
+   * The first bindings are tracked, the others are always issued.
+   *
+   * @param index The binding point.
+   * @param buffer The buffer.
+   * @param offset The start of the range, a multiple of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+   * @param size The size of the range.
+   */
+   static void bindUniformRange(unsigned int index, unsigned int buffer, unsigned int offset, unsigned int size);
+
+   /**
+   * @brief Delete a buffer, forgetting the ranges bound from it
+   *
+   * @param buffer The buffer.
+   */
+   static void deleteBuffer(unsigned int buffer);
+
+   /**
+   * @brief Set the viewport
+   *
+   * @param x The left edge.
+   * @param y The bottom edge.
+   * @param width The width.
+   * @param height The height.
+   */
+   static void viewport(int x, int y, int width, int height);
+
+   /**
+   * @brief Get the viewport
+   *
+   * Read from the shadow: the driver is only queried when the viewport is not known (after invalidate()).
+   *
+   * @return The viewport: x, y, width and height.
+   */
+   static const glm::ivec4& getViewport();
+
+   /**
+   * @brief Set the scissor box
+   *
+   * @param x The left edge.
+   * @param y The bottom edge.
+   * @param width The width.
+   * @param height The height.
+   */
+   static void scissor(int x, int y, int width, int height);
+
+   /**
+   * @brief Enable a capability
+   *
+   * GL_DEPTH_TEST, GL_BLEND, GL_SCISSOR_TEST and GL_CULL_FACE are tracked, the others are always issued.
+   *
+   * @param capability The capability.
+   */
+   static void enable(unsigned int capability);
+
+   /**
+   * @brief Disable a capability
+   *
+   * @param capability The capability.
+   */
+   static void disable(unsigned int capability);
+
+   /**
+   * @brief Set the depth comparison
+   *
+   * @param func The depth function.
+   */
+   static void depthFunc(unsigned int func);
+
+   /**
+   * @brief Set the blend factors
+   *
+   * @param source The source factor.
+   * @param destination The destination factor.
+   */
+   static void blendFunc(unsigned int source, unsigned int destination);
+
+   /**
+   * @brief Enable or disable the validation mode
+   *
+   * When enabled, the shadow is compared with the real state after every call and the
+   * differences are reported. Slow: every check reads the state back from the driver.
+   *
+   * @param enable True to validate.
+   */
+   static void setValidation(bool enable);
+
+   /**
+   * @brief Compare the shadow with the real state
+   *
+   * The entries not known to the shadow are skipped.
+   *
+   * @return True if the shadow matches.
+   */
+   static bool validate();
+
+   /**
+   * @brief Get the call counters
+   *
+   * @return The calls issued and skipped since the last resetStats().
+   */
+   static const GlStateStats& getStats();
+
+   /**
+   * @brief Reset the call counters
+   */
+   static void resetStats();
+};
+
+#endif // GL_STATE_H
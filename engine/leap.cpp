@@ -154,7 +154,7 @@ bool Eng::Leap::init()
       }
 
    glGenVertexArrays(1, &globalVao);
-   glBindVertexArray(globalVao);
+   GlState::bindVertexArray(globalVao);
 
    glGenBuffers(1, &vertexVbo);
    glBindBuffer(GL_ARRAY_BUFFER, vertexVbo);
@@ -243,12 +243,6 @@ glm::vec3 leapToVec(const LEAP_VECTOR& leapVec) {
    return glm::vec3(leapVec.x, leapVec.y, leapVec.z);
 }
 
-bool puntoNelRaggio(const glm::vec3& punto, const glm::vec3& centroSfera, float raggio) {
-   // Calcolare la distanza quadrata tra il punto e il centro della sfera usando il prodotto scalare
-   float distanzaQuadrata = glm::dot(punto - centroSfera, punto - centroSfera);
-   // Confrontare con il quadrato del raggio
-   return distanzaQuadrata <= raggio * raggio;
-}
 static std::vector<Eng::Node*> grabbedNodes = { nullptr, nullptr }; /**< Pointers to the ojects grabbed with the 2 hands */
 static std::vector<glm::vec3> grabOffsets; /**< Offset of the center of the grabbed object from the pinch position */
 static std::vector<glm::vec3> originalPositions; /**< Original position of the objects grabbed with the 2 hands */
@@ -262,8 +256,8 @@ static bool firstRun = true; /**< Check for first run initialization */
     * @param projMatrix The projMatrix.
     */
 void Eng::Leap::renderNormalHandBones(const LEAP_TRACKING_EVENT* l, const glm::mat4 modelViewMat, const glm::mat4 projMatrix) {
-   glBindVertexArray(globalVao);
-   Shader::getCurrentShader()->setMatrix("projection", projMatrix);
+   GlState::bindVertexArray(globalVao);
+   Shader::getCurrentShader()->setMatrix(Shader::UNIFORM_PROJECTION, projMatrix);
 
    glm::vec3 scaleFactor(0.2f); // Riduce la dimensione e la distanza al 20%
 
@@ -294,44 +288,41 @@ void Eng::Leap::renderNormalHandBones(const LEAP_TRACKING_EVENT* l, const glm::m
       Node* grabbedNode = grabbedNodes[h];
       glm::vec3 grabOffset = grabOffsets[h];
 
-      for (auto& node : pickableNodes) {
-         glm::vec3 nodeCenter = node->getWorldPosition();
-         float radius = node->getBoundingSphereRadius();
-
-         bool isInsideSphere = puntoNelRaggio(pinchWorldPos, nodeCenter, radius);
-         bool alreadyGrabbed = std::find(grabbedNodes.begin(), grabbedNodes.end(), node) != grabbedNodes.end();
-
-         if (grabbedNode == nullptr && isInsideSphere && isPinching && !alreadyGrabbed) {
-            grabbedNode = node;
-            grabOffset = pinchWorldPos - nodeCenter;
-         }
+      if (pickGrid == nullptr)
+         continue;
 
-         if (grabbedNode == node && isPinching) {
-            handIsGrabbing = true;
+      // Nearest free node whose bounding sphere contains the pinch:
+      if (grabbedNode == nullptr && isPinching) {
+         grabbedNode = pickGrid->findNearest(pinchWorldPos, 1.0f, grabbedNodes);
+         if (grabbedNode != nullptr)
+            grabOffset = pinchWorldPos - grabbedNode->getWorldPosition();
+      }
 
-            Shader::getCurrentShader()->setVec3("color", glm::vec3(0.5f, 0.0f, 0.5f));  // Colore viola quando si afferra un oggetto
+      if (grabbedNode != nullptr && isPinching) {
+         handIsGrabbing = true;
 
-            glm::vec3 newPosition = pinchWorldPos - grabOffset;
-            glm::mat4 newTransform = glm::translate(glm::mat4(1.0f), newPosition);
-            grabbedNode->setTransform(newTransform);
-            grabbedNode->setWorldPosition(newPosition);
-         }
+         Shader::getCurrentShader()->setVec3(Shader::UNIFORM_COLOR, glm::vec3(0.5f, 0.0f, 0.5f));  // Colore viola quando si afferra un oggetto
 
-         if (!isPinching && grabbedNode == node) {
-            grabbedNode = nullptr;
-         }
+         glm::vec3 newPosition = pinchWorldPos - grabOffset;
+         glm::mat4 newTransform = glm::translate(glm::mat4(1.0f), newPosition);
+         grabbedNode->setTransform(newTransform);
+         grabbedNode->setWorldPosition(newPosition);
+      }
 
-         grabbedNodes[h] = grabbedNode;
-         grabOffsets[h] = grabOffset;
+      if (!isPinching) {
+         grabbedNode = nullptr;
       }
 
+      grabbedNodes[h] = grabbedNode;
+      grabOffsets[h] = grabOffset;
+
       // Se non si sta afferrando nulla, la mano prende il colore normale
       if (!isPinching || !handIsGrabbing) {
-         Shader::getCurrentShader()->setVec3("color", glm::vec3((float)h, (float)(1 - h), 0.5f));  // Colore normale
+         Shader::getCurrentShader()->setVec3(Shader::UNIFORM_COLOR, glm::vec3((float)h, (float)(1 - h), 0.5f));  // Colore normale
       }
       // Se si sta facendo un pinch ma non si afferra nulla, coloriamo diversamente (ad esempio in giallo)
       else if (isPinching && !handIsGrabbing) {
-         Shader::getCurrentShader()->setVec3("color", glm::vec3(1.0f, 1.0f, 0.0f));  // Colore giallo per pinch senza afferrare
+         Shader::getCurrentShader()->setVec3(Shader::UNIFORM_COLOR, glm::vec3(1.0f, 1.0f, 0.0f));  // Colore giallo per pinch senza afferrare
       }
 
       // --- Elbow ---
@@ -339,7 +330,7 @@ void Eng::Leap::renderNormalHandBones(const LEAP_TRACKING_EVENT* l, const glm::m
          glm::vec3 pos(hand.arm.prev_joint.x, hand.arm.prev_joint.y, hand.arm.prev_joint.z);
          glm::mat4 t = glm::translate(glm::mat4(1.0f), pos * scaleFactor);
          glm::mat4 s = glm::scale(glm::mat4(1.0f), scaleFactor);
-         Shader::getCurrentShader()->setMatrix("modelview", f * t * s);
+         Shader::getCurrentShader()->setMatrix(Shader::UNIFORM_MODELVIEW, f * t * s);
          glDrawArrays(GL_TRIANGLE_STRIP, 0, (GLsizei)vertices.size());
       }
 
@@ -348,7 +339,7 @@ void Eng::Leap::renderNormalHandBones(const LEAP_TRACKING_EVENT* l, const glm::m
          glm::vec3 pos(hand.arm.next_joint.x, hand.arm.next_joint.y, hand.arm.next_joint.z);
          glm::mat4 t = glm::translate(glm::mat4(1.0f), pos * scaleFactor);  // Applica la scala alla posizione
          glm::mat4 s = glm::scale(glm::mat4(1.0f), scaleFactor);  // Scala solo la geometria
-         Shader::getCurrentShader()->setMatrix("modelview", f * t * s);
+         Shader::getCurrentShader()->setMatrix(Shader::UNIFORM_MODELVIEW, f * t * s);
          glDrawArrays(GL_TRIANGLE_STRIP, 0, (GLsizei)vertices.size());
       }
 
@@ -357,7 +348,7 @@ void Eng::Leap::renderNormalHandBones(const LEAP_TRACKING_EVENT* l, const glm::m
          glm::vec3 pos(hand.palm.position.x, hand.palm.position.y, hand.palm.position.z);
          glm::mat4 t = glm::translate(glm::mat4(1.0f), pos * scaleFactor);  // Applica la scala alla posizione
          glm::mat4 s = glm::scale(glm::mat4(1.0f), scaleFactor);  // Scala solo la geometria
-         Shader::getCurrentShader()->setMatrix("modelview", f * t * s);
+         Shader::getCurrentShader()->setMatrix(Shader::UNIFORM_MODELVIEW, f * t * s);
          glDrawArrays(GL_TRIANGLE_STRIP, 0, (GLsizei)vertices.size());
       }
 
@@ -369,13 +360,13 @@ void Eng::Leap::renderNormalHandBones(const LEAP_TRACKING_EVENT* l, const glm::m
             glm::vec3 pos(bone.next_joint.x, bone.next_joint.y, bone.next_joint.z);
             glm::mat4 t = glm::translate(glm::mat4(1.0f), pos * scaleFactor);
             glm::mat4 s = glm::scale(glm::mat4(1.0f), scaleFactor); 
-            Shader::getCurrentShader()->setMatrix("modelview", f * t * s);
+            Shader::getCurrentShader()->setMatrix(Shader::UNIFORM_MODELVIEW, f * t * s);
             glDrawArrays(GL_TRIANGLE_STRIP, 0, (GLsizei)vertices.size());
          }
       }
    }
 
-   glBindVertexArray(0);
+   GlState::bindVertexArray(0);
 }
 
 
@@ -398,8 +389,8 @@ glm::vec3 leapToMeters(const LEAP_VECTOR& leapVec) {
     * @param leapToWorldMatrix The position of the leapMotion.
     */
 void Eng::Leap::renderVRHandBones(const LEAP_TRACKING_EVENT* l, const glm::mat4 modelViewMat, const glm::mat4 projMatrix, const glm::mat4 leapToWorldMatrix) {
-   glBindVertexArray(globalVao);
-   Shader::getCurrentShader()->setMatrix("projection", projMatrix);
+   GlState::bindVertexArray(globalVao);
+   Shader::getCurrentShader()->setMatrix(Shader::UNIFORM_PROJECTION, projMatrix);
 
    const float margin = 0.10f;
    const float xMin = -0.054846f - (0.216109f * margin);
@@ -451,16 +442,7 @@ void Eng::Leap::renderVRHandBones(const LEAP_TRACKING_EVENT* l, const glm::mat4
          glm::vec3 currentPos = grabbedNode->getWorldPosition();
          if (!isInsideValidArea(currentPos) && !isInCemeteryArea(currentPos)) {
             glm::vec3 newPos = glm::vec3(originalPositions[h].x, originalPositions[h].y, originalPositions[h].z);
-            grabbedNode->setWorldPosition(newPos);
-
-            const glm::mat4 currentTransform = grabbedNode->getTransform();
-            const glm::vec3 currentScale(
-               glm::length(glm::vec3(currentTransform[0])),
-               glm::length(glm::vec3(currentTransform[1])),
-               glm::length(glm::vec3(currentTransform[2]))
-            );
-            const glm::mat4 newTransform = glm::translate(glm::mat4(1.0f), newPos) * glm::scale(glm::mat4(1.0f), currentScale);
-            grabbedNode->setTransform(newTransform);
+            grabbedNode->setLocalPosition(newPos);
 
             grabbedNodes[h] = nullptr;
             grabbedNode = nullptr;
@@ -468,16 +450,7 @@ void Eng::Leap::renderVRHandBones(const LEAP_TRACKING_EVENT* l, const glm::mat4
          }
          else {
             glm::vec3 newPos = glm::vec3(currentPos.x, originalPositions[h].y, currentPos.z);
-            grabbedNode->setWorldPosition(newPos);
-
-            const glm::mat4 currentTransform = grabbedNode->getTransform();
-            const glm::vec3 currentScale(
-               glm::length(glm::vec3(currentTransform[0])),
-               glm::length(glm::vec3(currentTransform[1])),
-               glm::length(glm::vec3(currentTransform[2]))
-            );
-            const glm::mat4 newTransform = glm::translate(glm::mat4(1.0f), newPos) * glm::scale(glm::mat4(1.0f), currentScale);
-            grabbedNode->setTransform(newTransform);
+            grabbedNode->setLocalPosition(newPos);
 
             grabbedNodes[h] = nullptr;
             grabbedNode = nullptr;
@@ -486,70 +459,48 @@ void Eng::Leap::renderVRHandBones(const LEAP_TRACKING_EVENT* l, const glm::mat4
          
       }
 
-      if (grabbedNode == nullptr && isPinching) {
-         for (auto& node : pickableNodes) {
-            bool alreadyGrabbed = std::find(grabbedNodes.begin(), grabbedNodes.end(), node) != grabbedNodes.end();
-            if (alreadyGrabbed) continue;
-
-            const glm::vec3 nodeCenter = node->getWorldPosition();
-            const float radius = node->getBoundingSphereRadius();
-            const float distance = glm::distance(pinchWorldPos, nodeCenter);
-
-            if (distance <= radius * 10.0f) {
-               grabbedNode = node;
-               grabOffset = pinchWorldPos - nodeCenter;
-               originalPositions[h] = nodeCenter;
-               break;
-            }
+      // Nearest free node within 10 bounding radii of the pinch:
+      if (grabbedNode == nullptr && isPinching && pickGrid != nullptr) {
+         grabbedNode = pickGrid->findNearest(pinchWorldPos, 10.0f, grabbedNodes);
+         if (grabbedNode != nullptr) {
+            const glm::vec3 nodeCenter = grabbedNode->getWorldPosition();
+            grabOffset = pinchWorldPos - nodeCenter;
+            originalPositions[h] = nodeCenter;
          }
       }
 
 
       if (isPinching && grabbedNode != nullptr) {
-         Shader::getCurrentShader()->setVec3("color", glm::vec3(0.5f, 0.0f, 0.5f)); 
-
-         const glm::mat4 currentTransform = grabbedNode->getTransform();
+         Shader::getCurrentShader()->setVec3(Shader::UNIFORM_COLOR, glm::vec3(0.5f, 0.0f, 0.5f)); 
 
-         // Extract scale
-         const glm::vec3 currentScale(
-            glm::length(glm::vec3(currentTransform[0])),
-            glm::length(glm::vec3(currentTransform[1])),
-            glm::length(glm::vec3(currentTransform[2]))
-         );
-
-         // Calculate new position
+         // Move the piece, rotation and scale are kept:
          const glm::vec3 newPosition = pinchWorldPos - grabOffset;
-
-         // Create new transform
-         const glm::mat4 newTransform = glm::translate(glm::mat4(1.0f), newPosition) * glm::scale(glm::mat4(1.0f), currentScale);
-
-         grabbedNode->setTransform(newTransform);
-         grabbedNode->setWorldPosition(newPosition);
+         grabbedNode->setLocalPosition(newPosition);
 
          grabbedNodes[h] = grabbedNode;
          grabOffsets[h] = grabOffset;
       }
       else if (isPinching) {
-         Shader::getCurrentShader()->setVec3("color", glm::vec3(1.0f, 1.0f, 0.0f)); 
+         Shader::getCurrentShader()->setVec3(Shader::UNIFORM_COLOR, glm::vec3(1.0f, 1.0f, 0.0f)); 
       }
       else {
-         Shader::getCurrentShader()->setVec3("color", glm::vec3((float)h, (float)(1 - h), 0.5f)); 
+         Shader::getCurrentShader()->setVec3(Shader::UNIFORM_COLOR, glm::vec3((float)h, (float)(1 - h), 0.5f)); 
       }
 
       glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(0.001f));
       // Elbow (gomito)
       glm::mat4 c = glm::translate(glm::mat4(1.0f), leapToMeters(hand.arm.prev_joint));
-      Shader::getCurrentShader()->setMatrix("modelview", f * c * scale);
+      Shader::getCurrentShader()->setMatrix(Shader::UNIFORM_MODELVIEW, f * c * scale);
       glDrawArrays(GL_TRIANGLE_STRIP, 0, (GLsizei)vertices.size());
 
       // Wrist (polso)
       c = glm::translate(glm::mat4(1.0f), leapToMeters(hand.arm.next_joint));
-      Shader::getCurrentShader()->setMatrix("modelview", f * c * scale);
+      Shader::getCurrentShader()->setMatrix(Shader::UNIFORM_MODELVIEW, f * c * scale);
       glDrawArrays(GL_TRIANGLE_STRIP, 0, (GLsizei)vertices.size());
 
       // Palm (palmo)
       c = glm::translate(glm::mat4(1.0f), leapToMeters(hand.palm.position));
-      Shader::getCurrentShader()->setMatrix("modelview", f * c * scale);
+      Shader::getCurrentShader()->setMatrix(Shader::UNIFORM_MODELVIEW, f * c * scale);
       glDrawArrays(GL_TRIANGLE_STRIP, 0, (GLsizei)vertices.size());
 
       // Distal ends of bones for each digit (distanza delle ossa per ogni dito)
@@ -558,19 +509,32 @@ void Eng::Leap::renderVRHandBones(const LEAP_TRACKING_EVENT* l, const glm::mat4
          for (unsigned int b = 0; b < 4; b++) {
             LEAP_BONE bone = finger.bones[b];
             c = glm::translate(glm::mat4(1.0f), leapToMeters(bone.next_joint));
-            Shader::getCurrentShader()->setMatrix("modelview", f * c * scale);
+            Shader::getCurrentShader()->setMatrix(Shader::UNIFORM_MODELVIEW, f * c * scale);
             glDrawArrays(GL_TRIANGLE_STRIP, 0, (GLsizei)vertices.size());
          }
       }
     } 
-   glBindVertexArray(0);
+   GlState::bindVertexArray(0);
+}
+
+/**
+    * @brief Set the spatial index of the pickable nodes.
+    *
+    * The grid is referenced, not copied: it must outlive the Leap object or be reset.
+    *
+    * @param pickGrid The pick grid.
+    */
+void Eng::Leap::setPickGrid(const PickGrid* pickGrid) {
+   this->pickGrid = pickGrid;
 }
 
 /**
-    * @brief Set the list of pickable nodes.
+    * @brief Release a node held by a hand.
+    *
+    * Called before a node is removed from the scene.
     *
-    * @param pickableNodes The list of pickable nodes.
+    * @param node The node.
     */
-void Eng::Leap::setPickableNodes(std::list<Node*> pickableNodes) {
-   this->pickableNodes = pickableNodes;
+void Eng::Leap::releaseNode(Node* node) {
+   std::replace(grabbedNodes.begin(), grabbedNodes.end(), node, (Node*)nullptr);
 }
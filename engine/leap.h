@@ -86,11 +86,22 @@ public: //
    void renderVRHandBones(const LEAP_TRACKING_EVENT* l, const glm::mat4 modelViewMat, const glm::mat4 projMatrix, const glm::mat4 leapToWorldMatrix);
 
    /**
-    * @brief Set the list of pickable nodes.
+    * @brief Set the spatial index of the pickable nodes.
     *
-    * @param pickableNodes The list of pickable nodes.
+    * The grid is referenced, not copied: it must outlive the Leap object or be reset.
+    *
+    * @param pickGrid The pick grid.
+    */
+   void setPickGrid(const PickGrid* pickGrid);
+
+   /**
+    * @brief Release a node held by a hand.
+    *
+    * Called before a node is removed from the scene.
+    *
+    * @param node The node.
     */
-   void setPickableNodes(std::list<Node*> pickableNodes);
+   void releaseNode(Node* node);
 
    ///////////	 
 private:	//
@@ -105,5 +116,5 @@ private:	//
    unsigned int globalVao, vertexVbo, colorVbo; /**< OpenGL buffers */
    std::vector<glm::vec3> vertices; /**< Vertices */
 
-   std::list<Node*> pickableNodes; /**< List of pickable nodes */
+   const PickGrid* pickGrid = nullptr; /**< Spatial index of the pickable nodes */
 };
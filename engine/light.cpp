@@ -32,8 +32,9 @@
 * @param ambient The ambient color of the light.
 * @param diffuse The diffuse color of the light.
 * @param specular The specular color of the light.
+* @param type The object type tag, set by the derived classes.
 */
-ENG_API Eng::Light::Light(const std::string name, const int lightNumber, const glm::vec3 ambient, const glm::vec3 diffuse, const glm::vec3 specular) : Node(name) {
+ENG_API Eng::Light::Light(const std::string name, const int lightNumber, const glm::vec3 ambient, const glm::vec3 diffuse, const glm::vec3 specular, ObjectType type) : Node(name, type) {
     this->lightNumber = lightNumber;
     this->ambient = ambient;
     this->diffuse = diffuse;
@@ -201,15 +202,91 @@ float ENG_API Eng::Light::getIntensity() const {
    return intensity;
 }
 
+/**
+* @brief Set the influence radius
+*
+* Objects farther than the radius are not lit. 0 means unlimited.
+*
+* @param radius The influence radius, in the local units of the light.
+*/
+void ENG_API Eng::Light::setInfluenceRadius(float radius) {
+   influenceRadius = std::max(radius, 0.0f);
+}
+
+/**
+* @brief Get the influence radius
+*
+* @return The influence radius, 0 if unlimited.
+*/
+float ENG_API Eng::Light::getInfluenceRadius() const {
+   return influenceRadius;
+}
+
+/**
+* @brief Check whether the light reaches a bounding sphere
+*
+* The base light has no position-dependent falloff and reaches everything.
+*
+* @param center The world center of the sphere.
+* @param radius The world radius of the sphere.
+* @return True if the light may affect the sphere.
+*/
+bool ENG_API Eng::Light::affects(const glm::vec3& center, float radius) {
+   return true;
+}
+
+/**
+* @brief Get a world sphere enclosing the influence of the light
+*
+* The base light reaches everything.
+*
+* @param center The world center of the sphere.
+* @param radius The world radius of the sphere.
+* @return False if the influence is unbounded.
+*/
+bool ENG_API Eng::Light::getInfluenceSphere(glm::vec3& center, float& radius) {
+   return false;
+}
+
+/**
+* @brief Get the influence radius in world units
+*
+* The largest axis scale of the world matrix is used, which keeps the test conservative.
+*
+* @return The influence radius scaled by the world matrix, 0 if unlimited.
+*/
+float Eng::Light::getWorldInfluenceRadius() {
+   if (influenceRadius <= 0.0f)
+      return 0.0f;
+
+   const glm::mat3 world(getFinalMatrix());
+   const float scale = std::max({ glm::length(world[0]), glm::length(world[1]), glm::length(world[2]) });
+   return influenceRadius * scale;
+}
+
 /**
 * @brief Render the light
 *
-* Renders the light using the given transformation matrix.
+* Nothing to do: the list uploads the blocks of all its lights and binds the slot of each pass.
 *
-* @param matrix The transformation matrix.
+* @param matrix The transformation matrix (unused: the block is in world space).
 * @param ptr A pointer to additional data.
 * @return True if the rendering was successful, false otherwise.
 */
 bool ENG_API Eng::Light::render(glm::mat4 matrix, void* ptr) {
    return true;
+}
+
+/**
+* @brief Fill the uniform block of the light
+*
+* @param block The block to fill.
+*/
+void ENG_API Eng::Light::getLightBlock(LightBlock& block) {
+   block.position = getFinalMatrix()[3];
+   block.direction = glm::vec4(0.0f);
+   block.ambient = glm::vec4(getAmbient(), 1.0f);
+   block.diffuse = glm::vec4(getDiffuse(), 1.0f);
+   block.specular = glm::vec4(getSpecular(), 1.0f);
+   block.attenuation = glm::vec4(getConstantAttenuation(), getLinearAttenuation(), getQuadraticAttenuation(), -1.0f);
 }
\ No newline at end of file
@@ -39,9 +39,10 @@ public:
     * @param ambient The ambient color of the light.
     * @param diffuse The diffuse color of the light.
     * @param specular The specular color of the light.
+    * @param type The object type tag, set by the derived classes.
     */
     Light(const std::string name, const int lightNumber,
-        const glm::vec3 ambient, const glm::vec3 diffuse, const glm::vec3 specular);
+        const glm::vec3 ambient, const glm::vec3 diffuse, const glm::vec3 specular, ObjectType type = ObjectType::LIGHT);
 
     /**
     * @brief Destructor
@@ -128,14 +129,23 @@ public:
     /**
     * @brief Render the light
     *
-    * Renders the light using the given transformation matrix.
+    * Nothing to do: the list uploads the blocks of all its lights and binds the slot of each pass.
     *
-    * @param transform The transformation matrix.
+    * @param transform The transformation matrix (unused: the block is in world space).
     * @param data A pointer to additional data.
     * @return True if the rendering was successful, false otherwise.
     */
     virtual bool render(glm::mat4 transform, void* data) override;
 
+    /**
+    * @brief Fill the uniform block of the light
+    *
+    * World position and colors with the attenuation factors. The derived classes add their own data.
+    *
+    * @param block The block to fill.
+    */
+    virtual void getLightBlock(LightBlock& block);
+
     /**
     * @brief Set the transformation matrix for the light
     *
@@ -173,6 +183,53 @@ public:
     */
     float getIntensity() const;
 
+    /**
+    * @brief Set the influence radius
+    *
+    * Objects farther than the radius are not lit. 0 means unlimited.
+    *
+    * @param radius The influence radius, in the local units of the light.
+    */
+    void setInfluenceRadius(float radius);
+
+    /**
+    * @brief Get the influence radius
+    *
+    * @return The influence radius, 0 if unlimited.
+    */
+    float getInfluenceRadius() const;
+
+    /**
+    * @brief Check whether the light reaches a bounding sphere
+    *
+    * Used to skip the objects a light pass does not affect. Conservative: may return true
+    * for a sphere the light does not reach, never false for a sphere it does.
+    *
+    * @param center The world center of the sphere.
+    * @param radius The world radius of the sphere.
+    * @return True if the light may affect the sphere (always true for directional lights).
+    */
+    virtual bool affects(const glm::vec3& center, float radius);
+
+    /**
+    * @brief Get a world sphere enclosing the influence of the light
+    *
+    * Used to scissor the light pass to the part of the screen the light can reach.
+    *
+    * @param center The world center of the sphere.
+    * @param radius The world radius of the sphere.
+    * @return False if the influence is unbounded (directional lights, no radius).
+    */
+    virtual bool getInfluenceSphere(glm::vec3& center, float& radius);
+
+protected:
+    /**
+    * @brief Get the influence radius in world units
+    *
+    * @return The influence radius scaled by the world matrix, 0 if unlimited.
+    */
+    float getWorldInfluenceRadius();
+
 private:
     static int nextNumber;  /**< The next available light number */
     int lightNumber;        /**< The number of the light */
@@ -185,6 +242,7 @@ private:
     float linearAttenuation = 0.0f;     /**< The linear attenuation factor */
     float quadraticAttenuation = 0.0f;  /**< The quadratic attenuation factor */
     float intensity = 7.0f;             /**< The intensity of the light */
+    float influenceRadius = 0.0f;       /**< The influence radius, 0 if unlimited */
 
 };
 
@@ -31,45 +31,462 @@
 * @param root Pointer to the root node to be added.
 */
 void ENG_API Eng::List::addEntry(Node* root) {
-    //don't get the root
-    Node* node = root->getChildAt(0);
+    rootsList.push_back(root);
+    addSubtree(root, false);
+    transformStore.invalidate();
+    visibilityCached = false;
+}
+
+/**
+* @brief Add a scene loaded in an arena
+*
+* The list takes the ownership of the arena: the scene objects are released
+* in bulk by clear().
+*
+* @param root Pointer to the root node of the scene.
+* @param arena The arena owning the scene objects.
+*/
+void ENG_API Eng::List::addEntry(Node* root, SceneArena* arena) {
+    arenas.push_back(arena);
+    addEntry(root);
+}
+
+/**
+* @brief Attach a node (and its subtree) to a node already in the list
+*
+* Only the new nodes are registered: the cost does not depend on the scene size.
+*
+* @param parent The new parent.
+* @param node The node to attach.
+*/
+void ENG_API Eng::List::addEntry(Node* parent, Node* node) {
+    parent->addChild(node);
+    addSubtree(node, true);
+    transformStore.invalidate();
+    visibilityCached = false;
+}
+
+/**
+* @brief Remove a node and its subtree from the list
+*
+* The node is detached from its parent (or from the roots). The nodes are not deleted.
+*
+* @param node The node to remove.
+* @return False if the node is not in the list.
+*/
+bool ENG_API Eng::List::removeEntry(Node* node) {
+    auto root = std::find(rootsList.begin(), rootsList.end(), node);
+    if (root != rootsList.end())
+        rootsList.erase(root);
+    else if (registry.findById(node->getId()).isNull())
+        return false;
+
+    // The store indices of the remaining nodes change: detach everything, rebuilt on the next update
+    transformStore.clear();
+
+    removeSubtree(node);
+    visibleObjects.clear();
+    frustumObjects.clear();
+    litObjects.clear();
+    litRanges.clear();
+    visibilityCached = false;
+    if (node->getParent() != nullptr) {
+        node->getParent()->removeChild(node);
+        node->setParent(nullptr);
+        node->setDirty();
+    }
+    return true;
+}
+
+/**
+* @brief Add the subtree of a node to the list
+*
+* @param root Pointer to the root of the subtree.
+* @param includeRoot True to add the root itself too.
+*/
+void Eng::List::addSubtree(Node* root, bool includeRoot) {
+    //insert nodes to list, depth-first
+    root->visitDepthFirst([this, root, includeRoot](Node* node) {
+        //don't get the root
+        if (node == root && !includeRoot)
+            return Node::VisitResult::CONTINUE;
+
+        registry.add(node);
 
-    int children = root->getNumberOfChildren();
-    //insert nodes to list
-    for (int i = 1; i <= children; i++) {
         //Add node
-        Light* v;
-        if ((v = dynamic_cast<Light*>(node))) {
-           lightsList.push_back(node);
+        if (node->isLight()) {
+           lights.add(node);
         }
         else {
            if (node->isGrabbablee()) {
-              pickableObjectsList.push_back(node);
+              pickables.add(node);
+              pickGrid.add(node);
            }
-           
-            objectsList.push_back(node);
+
+            objects.add(node);
         }
-        //Add children of children
-        if (node != NULL && node->getNumberOfChildren() > 0) {
-            addEntry(node);
+        return Node::VisitResult::CONTINUE;
+    });
+}
+
+/**
+* @brief Remove a node and its subtree from the collections
+*
+* @param root Pointer to the root of the subtree.
+*/
+void Eng::List::removeSubtree(Node* root) {
+    root->visitDepthFirst([this](Node* node) {
+        registry.remove(node);
+        lights.remove(node);
+        pickables.remove(node);
+        pickGrid.remove(node);
+        objects.remove(node);
+        return Node::VisitResult::CONTINUE;
+    });
+}
+
+/**
+* @brief Update the world matrices of all the scenes in the list
+*
+* Runs the top-down transform pass once per frame, before rendering.
+* Only the dirty nodes recompute their world matrix and world bounds.
+* The roots are updated first, then every child subtree of a root is
+* an independent task for the worker pool.
+* The subtree bounds are then refit bottom-up along the changed branches,
+* and the moved pickable objects are binned again in the pick grid.
+*/
+void ENG_API Eng::List::updateWorldTransforms() {
+    // Moved nodes flag their roots until the refit: remembered for the visibility cache
+    bool moved = false;
+    for (Node* root : rootsList)
+        moved |= root->hasDirtyBounds();
+    boundsChanged |= moved;
+
+    updateHierarchy();
+
+    // Only the pickable objects reported by the update above change cell:
+    pickGrid.refresh();
+}
+
+/**
+* @brief Run the transform pass and the bounds refit
+*
+* Serial, parallel or flat, see updateWorldTransforms().
+*/
+void Eng::List::updateHierarchy() {
+
+    if (flatTransforms) {
+        if (!transformStore.isValid())
+            transformStore.build(rootsList);
+        transformStore.update();
+        for (Node* root : rootsList)
+            root->refitBounds();
+        return;
+    }
+
+    // Small scenes: synchronizing the workers costs more than the update
+    if (workerPool.getThreadCount() < 2 || objects.size() + lights.size() < parallelThreshold) {
+        for (Node* root : rootsList) {
+            root->updateWorldTransforms();
+            root->refitBounds();
         }
-        node = root->getChildAt(i);
+        return;
+    }
+
+    updateTasks.clear();
+    for (Node* root : rootsList) {
+        root->updateWorldMatrix();
+        for (Node* child : root->getChildSpan())
+            updateTasks.push_back(child);
     }
+
+    // Every task writes only its own subtree:
+    workerPool.parallelFor((unsigned int)updateTasks.size(), [this](unsigned int i) {
+        updateTasks[i]->updateWorldTransforms();
+        updateTasks[i]->refitBounds();
+    });
+
+    // The child subtrees are clean: only the roots are left
+    for (Node* root : rootsList)
+        root->refitBounds();
+}
+
+/**
+* @brief Set the number of threads of the update stage
+*
+* The children of the scene roots are independent subtrees and are updated in parallel.
+*
+* @param threads The number of threads, the render thread included (0 or 1 means serial).
+*/
+void ENG_API Eng::List::setUpdateThreads(unsigned int threads) {
+    workerPool.start(threads);
+}
+
+/**
+* @brief Enable or disable the flat transform storage
+*
+* When enabled, the local and world matrices of all the nodes are kept in a
+* TransformStore and updated with a single linear loop.
+*
+* @param enable True to use the flat storage.
+*/
+void ENG_API Eng::List::setFlatTransforms(bool enable) {
+    flatTransforms = enable;
+    if (enable)
+        transformStore.build(rootsList);
+    else
+        transformStore.clear();
 }
 
 /**
 * @brief Remove the last entry from the list
 *
-* Removes the last node from the list.
+* Removes the last node of getObjectList() and its subtree, as removeEntry() does. Removals
+* reorder the list: it is not the last node added. The node is not deleted.
 */
 void ENG_API Eng::List::popEntry() {
-    objectsList.pop_back();
+    if (objects.size() > 0)
+        removeEntry(objects.at(objects.size() - 1));
+}
+
+/**
+* @brief Compute the visible objects of the frame
+*
+* Runs once per frame, after the world update: the scene hierarchy is culled against a single
+* frustum enclosing all the views (both eyes), then the objects below their detail thresholds
+* and the occluded objects are removed. The result is shared by every light pass and every view.
+*
+* @param viewProjections The View-Projection matrices of the views.
+* @param count The number of views.
+*/
+void ENG_API Eng::List::updateVisibility(const glm::mat4* viewProjections, unsigned int count) {
+   visibleObjects.clear();
+   visibilityReused = false;
+   if (count == 0)
+      return;
+
+   // Temporal coherence: nothing moved and the views are still inside the enlarged frustum of the cache
+   for (Node* root : rootsList)
+      boundsChanged |= root->hasDirtyBounds();
+   if (visibilityCached && !boundsChanged && cacheMargin > 0.0f) {
+      glm::vec3 sceneMin(FLT_MAX), sceneMax(-FLT_MAX);
+      for (Node* root : rootsList) {
+         sceneMin = glm::min(sceneMin, root->getSubtreeMin());
+         sceneMax = glm::max(sceneMax, root->getSubtreeMax());
+      }
+      visibilityReused = true;
+      for (unsigned int v = 0; v < count && visibilityReused; v++)
+         visibilityReused = cachedFrustum.containsFrustum(viewProjections[v], sceneMin, sceneMax);
+   }
+
+   if (!visibilityReused)
+      updateFrustumObjects(viewProjections, count);
+   boundsChanged = false;
+   visibleObjects.assign(frustumObjects.begin(), frustumObjects.end());
+
+   renderQueue.resetStats();
+
+   // The lights may have moved: their blocks go up once, before the first view of the frame
+   lightBlocksDirty = true;
+
+   // Small and distant props, view dependent: runs even when the frustum stage is reused
+   cullDetail(viewProjections, count);
+
+   // Occlusion stage, tested in each view:
+   if (occlusionCulling)
+      occlusionCuller.cull(visibleObjects, viewProjections, count);
+
+   updateLitObjects();
+}
+
+/**
+* @brief Remove the visible objects below their detail thresholds
+*
+* The projected size is the bounding radius scaled by the vertical projection term over the view
+* depth; an object is kept if it passes both tests in at least one view. The camera inside the
+* bounding sphere always keeps the object.
+*
+* @param viewProjections The View-Projection matrices of the views.
+* @param count The number of views.
+*/
+void Eng::List::cullDetail(const glm::mat4* viewProjections, unsigned int count) {
+   smallCulledCount = 0;
+   distanceCulledCount = 0;
+
+   unsigned int kept = 0;
+   for (Node* node : visibleObjects) {
+      const float minSize = node->getMinScreenSize() < 0.0f ? defaultMinScreenSize : node->getMinScreenSize();
+      const float maxDistance = node->getMaxDrawDistance() < 0.0f ? defaultMaxDrawDistance : node->getMaxDrawDistance();
+      if (minSize <= 0.0f && maxDistance <= 0.0f) {
+         visibleObjects[kept++] = node;
+         continue;
+      }
+
+      const glm::vec4 center(node->getWorldCenter(), 1.0f);
+      const float radius = node->getWorldRadius();
+      bool nearEnough = false, largeEnough = false;
+      for (unsigned int v = 0; v < count && !largeEnough; v++) {
+         // Row 3 gives the view depth, row 1 the vertical scale of the projection:
+         const glm::mat4 transposed = glm::transpose(viewProjections[v]);
+         const float depth = glm::dot(transposed[3], center);
+         const bool inside = depth <= radius;
+         const bool near = maxDistance <= 0.0f || depth - radius <= maxDistance;
+         const bool large = minSize <= 0.0f || inside || radius * glm::length(glm::vec3(transposed[1])) >= minSize * depth;
+         nearEnough |= near;
+         largeEnough |= near && large;
+      }
+
+      if (largeEnough)
+         visibleObjects[kept++] = node;
+      else if (!nearEnough)
+         distanceCulledCount++;
+      else
+         smallCulledCount++;
+   }
+   visibleObjects.resize(kept);
+}
+
+/**
+* @brief Set the detail culling thresholds of a whole subtree
+*
+* Groups of props (e.g. the captured pieces) share their thresholds through their parent node.
+*
+* @param root The root of the subtree, included.
+* @param minScreenSize The minimum projected diameter, negative for the default.
+* @param maxDrawDistance The maximum draw distance, negative for the default.
+*/
+void ENG_API Eng::List::setDetailThresholds(Node* root, float minScreenSize, float maxDrawDistance) {
+   root->visitDepthFirst([minScreenSize, maxDrawDistance](Node* node) {
+      node->setDetailThresholds(minScreenSize, maxDrawDistance);
+      return Node::VisitResult::CONTINUE;
+   });
+}
+
+/**
+* @brief Split the visible objects by light
+*
+* Every light keeps the visible objects inside its influence (all of them for directional lights).
+* Runs once per frame: the lists are shared by both eyes.
+*/
+void Eng::List::updateLitObjects() {
+   litObjects.clear();
+   litRanges.clear();
+   for (Node* lightNode : lights) {
+      Light* light = static_cast<Light*>(lightNode);
+      litRanges.push_back((unsigned int)litObjects.size());
+      for (Node* node : visibleObjects)
+         if (light->affects(node->getWorldCenter(), node->getWorldRadius()))
+            litObjects.push_back(node);
+   }
+   litRanges.push_back((unsigned int)litObjects.size());
+}
+
+/**
+* @brief Get the objects lit by a light in the last visibility stage
+*
+* @param light The index of the light, in the order of the light passes.
+* @return The visible objects inside the influence of the light.
+*/
+std::span<Eng::Node* const> ENG_API Eng::List::getLitObjects(unsigned int light) const {
+   if (light + 1 >= litRanges.size())
+      return {};
+   return std::span<Node* const>(litObjects).subspan(litRanges[light], litRanges[light + 1] - litRanges[light]);
+}
+
+/**
+* @brief Run the frustum stage
+*
+* The frustum enclosing all the views is enlarged by the cache margin and kept for the
+* next frames.
+*
+* @param viewProjections The View-Projection matrices of the views.
+* @param count The number of views.
+*/
+void Eng::List::updateFrustumObjects(const glm::mat4* viewProjections, unsigned int count) {
+   frustumObjects.clear();
+   cullCandidates.clear();
+   candidateSpheres.clear();
+
+   Eng::Frustum frustum = extractFrustumPlanes(viewProjections[0]);
+   for (unsigned int v = 1; v < count; v++)
+      frustum.expandToContain(viewProjections[v]);
+   frustum.expand(cacheMargin);
+   cachedFrustum = frustum;
+   visibilityCached = true;
+
+   // The roots are not in the list, only their subtrees:
+   for (Node* root : rootsList) {
+      unsigned char planeMask = 0x3F, plane = root->getCullPlane();
+      const FrustumTest test = frustum.testBox(root->getSubtreeMin(), root->getSubtreeMax(), planeMask, plane);
+      if (test == FrustumTest::OUTSIDE) {
+         root->setCullPlane(plane);
+         continue;
+      }
+      for (Node* child : root->getChildSpan())
+         cullSubtree(child, frustum, planeMask);
+   }
+
+   // Objects in the subtrees crossing the frustum, tested in SIMD batches:
+   frustum.testSpheres(candidateSpheres, candidateMask);
+   glm::vec3 boxMin, boxMax;
+   for (unsigned int i = 0; i < (unsigned int)cullCandidates.size(); i++) {
+      if (!(candidateMask[i / 32] & (1u << (i % 32))))
+         continue;
+
+      // Second stage: the oriented box rejects the flat and elongated meshes the sphere lets through
+      Node* node = cullCandidates[i];
+      if (node->getBoundingBox(boxMin, boxMax) && !frustum.orientedBoxInFrustum(node->getFinalMatrix(), boxMin, boxMax))
+         continue;
+      frustumObjects.push_back(node);
+   }
+}
+
+/**
+* @brief Collect the visible objects of a subtree
+*
+* The subtree AABB is tested first: a subtree fully outside is skipped, a subtree
+* fully inside is accepted without further tests. The other objects are queued for
+* the batched sphere test.
+*
+* @param node The root of the subtree.
+* @param frustum The culling frustum.
+* @param planeMask The planes the parent crosses, the others are skipped (0 when fully inside).
+*/
+void Eng::List::cullSubtree(Node* node, const Frustum& frustum, unsigned char planeMask) {
+   if (planeMask != 0) {
+      unsigned char plane = node->getCullPlane();
+      const FrustumTest test = frustum.testBox(node->getSubtreeMin(), node->getSubtreeMax(), planeMask, plane);
+      if (test == FrustumTest::OUTSIDE) {
+         node->setCullPlane(plane);
+         return;
+      }
+   }
+   const bool inside = planeMask == 0;
+
+   // Salta le luci e i nodi senza geometria
+   if (!node->isLight() && node->getObjectType() != ObjectType::NODE) {
+      if (inside)
+         frustumObjects.push_back(node);
+      else {
+         cullCandidates.push_back(node);
+         candidateSpheres.push(node->getWorldCenter(), node->getWorldRadius());
+      }
+   }
+
+   for (Node* child : node->getChildSpan())
+      cullSubtree(child, frustum, planeMask);
 }
 
 /**
 * @brief Render the list
 *
-* Renders the list using the given transformation matrix.
+* Renders the visible objects using the given transformation matrix.
+* The first light pass draws every visible object and lays down the depth, the additive
+* passes of the other lights only draw the objects inside the influence of the light, scissored
+* to its screen rectangle. Lights entirely off-screen are skipped.
+* The meshes of all the passes go through the render queue: within a pass they are grouped by
+* shader, material, texture and VAO, then drawn front-to-back.
+* The light blocks are uploaded by the first view of the frame, every pass binds the block of its light.
 *
 * @param cameraMatrix The transformation matrix.
 * @param ptr A pointer to additional data.
@@ -77,73 +494,176 @@ void ENG_API Eng::List::popEntry() {
 */
 bool Eng::List::render(glm::mat4 inverseCameraMatrix, glm::mat4 projectionMatrix, void* ptr) {
 
-   std::list<Node*>::iterator lightsIt;
-   int index = 0;
+   unsigned int index = 0;
+   const glm::mat4 viewProjection = projectionMatrix * inverseCameraMatrix;
+   const glm::ivec4 viewport = GlState::getViewport();
+   bool scissor = false;
 
-   for (lightsIt = lightsList.begin(); lightsIt != lightsList.end(); lightsIt++, index++) {
-      if (index == 1) {
-         glEnable(GL_BLEND);
-         glBlendFunc(GL_ONE, GL_ONE);
-      }
-      
-      Light* light = dynamic_cast<Light*>(*lightsIt);
-      if (light) {
-         if (dynamic_cast<DirectionalLight*>(light)) {
-         }
-         else if (dynamic_cast<SpotLight*>(light)) {
-         }
-         else if (dynamic_cast<PointLight*>(light)) {
+   // Draws of all the passes, sorted by pass, then by state, then front-to-back:
+   renderQueue.clear();
+   const glm::vec4 depthRow = glm::transpose(inverseCameraMatrix)[2];
+   unsigned int otherObjects = 0;
+   for (unsigned int pass = 0; pass < lights.size(); pass++)
+      for (Node* node : pass == 0 ? getVisibleObjects() : getLitObjects(pass)) {
+         if (node->getObjectType() != ObjectType::MESH) {
+            otherObjects++;
+            continue;
          }
-         light->render(inverseCameraMatrix * light->getFinalMatrix(), ptr);
+         renderQueue.push(static_cast<Mesh*>(node), pass, -glm::dot(depthRow, glm::vec4(node->getWorldCenter(), 1.0f)));
       }
+   renderQueue.sort();
+   std::span<const RenderItem> items = renderQueue.getItems();
 
-      glm::mat4 vp = projectionMatrix * inverseCameraMatrix;
-      Eng::Frustum frustum = extractFrustumPlanes(vp);
+   // Light data is in world space, shared by all the views of the frame:
+   if (lightBlocksDirty) {
+      lightBlocks.resize(lights.size());
+      unsigned int slot = 0;
+      for (Node* lightNode : lights)
+         static_cast<Light*>(lightNode)->getLightBlock(lightBlocks[slot++]);
+      UniformBuffers::setLights(lightBlocks);
+      lightBlocksDirty = false;
+   }
+   size_t next = 0;
+   renderQueue.begin();
 
-      std::list<Node*>::iterator nodesIt;
-      for (auto& nodePtr : objectsList) {
-         Node* node = dynamic_cast<Node*>(nodePtr);
-         if (!node) {
-            continue;  // Salta se l'elemento non  un nodo
-         }
+   for (Node* lightNode : lights) {
+      if (index == 1) {
+         GlState::enable(GL_BLEND);
+         GlState::blendFunc(GL_ONE, GL_ONE);
+      }
+
+      // Oggetti visibili calcolati una volta per frame da updateVisibility()
+      const bool additive = index > 0;
+      std::span<Node* const> passObjects = additive ? getLitObjects(index) : getVisibleObjects();
+      const unsigned int pass = index++;
+      while (next < items.size() && items[next].getPass() < pass)
+         next++;
+      if (passObjects.empty())
+         continue;
 
-         glm::vec3 worldPosition = glm::vec3(node->getFinalMatrix()[3]);
-         float radius = node->getBoundingSphereRadius();
+      // The lights set only holds nodes tagged as lights:
+      Light* light = static_cast<Light*>(lightNode);
 
-         // Controllo se la sfera del nodo  visibile nel frustum
-         if (frustum.sphereInFrustum(worldPosition, radius)) {
-            glm::mat4 nodeTransform = inverseCameraMatrix * node->getFinalMatrix();
-            node->render(nodeTransform, ptr);
+      // Additive passes only touch the pixels the light can reach:
+      if (additive) {
+         glm::ivec4 rect;
+         if (!influenceRect(light, viewProjection, viewport, rect))
+            continue;
+         const bool fullScreen = rect == viewport;
+         if (fullScreen && scissor)
+            GlState::disable(GL_SCISSOR_TEST);
+         else if (!fullScreen) {
+            if (!scissor)
+               GlState::enable(GL_SCISSOR_TEST);
+            GlState::scissor(rect.x, rect.y, rect.z, rect.w);
          }
+         scissor = !fullScreen;
       }
 
+      UniformBuffers::bindLight(pass);
+
+      // Objects other than meshes draw themselves:
+      if (otherObjects > 0) {
+         for (Node* node : passObjects)
+            if (node->getObjectType() != ObjectType::MESH)
+               node->render(inverseCameraMatrix * node->getFinalMatrix(), ptr);
+         renderQueue.begin();
+      }
+
+      for (; next < items.size() && items[next].getPass() == pass; next++)
+         renderQueue.draw(items[next], inverseCameraMatrix);
    }
+   renderQueue.end();
 
-   if (lightsList.size() > 1)
-      glDisable(GL_BLEND);
+   if (scissor)
+      GlState::disable(GL_SCISSOR_TEST);
+   if (lights.size() > 1)
+      GlState::disable(GL_BLEND);
 
    return true;
 }
 
+/**
+* @brief Get the screen rectangle of the influence of a light
+*
+* The corners of the box around the influence sphere are projected; a box crossing the eye plane
+* covers the whole viewport.
+*
+* @param light The light.
+* @param viewProjection The View-Projection matrix of the view.
+* @param viewport The viewport: x, y, width and height.
+* @param rect The rectangle, x, y, width and height in pixels.
+* @return False if the influence is entirely off-screen.
+*/
+bool Eng::List::influenceRect(Light* light, const glm::mat4& viewProjection, const glm::ivec4& viewport, glm::ivec4& rect) {
+   rect = viewport;
+
+   glm::vec3 center;
+   float radius;
+   if (!light->getInfluenceSphere(center, radius))
+      return true;
+
+   glm::vec2 lo(FLT_MAX), hi(-FLT_MAX);
+   for (unsigned int c = 0; c < 8; c++) {
+      const glm::vec3 corner = center + radius * glm::vec3(c & 1 ? 1.0f : -1.0f, c & 2 ? 1.0f : -1.0f, c & 4 ? 1.0f : -1.0f);
+      const glm::vec4 clip = viewProjection * glm::vec4(corner, 1.0f);
+      if (clip.w <= FLT_EPSILON)
+         return true;
+      const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+      lo = glm::min(lo, ndc);
+      hi = glm::max(hi, ndc);
+   }
+
+   lo = glm::clamp(lo, -1.0f, 1.0f);
+   hi = glm::clamp(hi, -1.0f, 1.0f);
+   if (lo.x >= hi.x || lo.y >= hi.y)
+      return false;
+
+   const glm::vec2 size(viewport.z, viewport.w);
+   const glm::ivec2 first = glm::ivec2(glm::floor((lo * 0.5f + 0.5f) * size));
+   const glm::ivec2 last = glm::ivec2(glm::ceil((hi * 0.5f + 0.5f) * size));
+   rect = glm::ivec4(viewport.x + first.x, viewport.y + first.y, last.x - first.x, last.y - first.y);
+   return true;
+}
+
 /**
 * @brief Clear the list
 *
-* Clears all nodes from the list.
+* Clears all nodes from the list. Heap allocated nodes, lights and scene roots included, are deleted one by one,
+* scene arenas are released in bulk.
 */
 void Eng::List::clear()
 {
-    std::list<Node*>::iterator it;
-    //Render each list element
-    for (it = objectsList.begin(); it != objectsList.end(); it++)
-    {
-        Light* v;
-        if ((v = dynamic_cast<Light*>(*it)))
-            delete (Light*)(*it);
-        else
-            delete (*it);
-    }
+    transformStore.clear();
+    registry.clear();
+    // The grid resets the nodes it indexes: before they are deleted
+    pickGrid.clear();
+
+    //Delete each node not owned by an arena: objects, lights and scene roots
+    const auto release = [this](Node* node) {
+        if (std::none_of(arenas.begin(), arenas.end(), [node](SceneArena* arena) { return arena->owns(node); }))
+            delete node;
+    };
+    for (Node* node : objects)
+        release(node);
+    for (Node* light : lights)
+        release(light);
+    for (Node* root : rootsList)
+        release(root);
 
-    objectsList.clear();
+    for (SceneArena* arena : arenas)
+        delete arena;
+    arenas.clear();
+
+    objects.clear();
+    visibleObjects.clear();
+    frustumObjects.clear();
+    litObjects.clear();
+    litRanges.clear();
+    visibilityCached = false;
+    lights.clear();
+    pickables.clear();
+    rootsList.clear();
 }
 
 /**
@@ -155,16 +675,9 @@ void Eng::List::clear()
 * @return Pointer to the node at the specified index.
 */
 Eng::Node ENG_API* Eng::List::getObject(int i) {
-    std::list<Node*>::iterator it;
-    int counter = 0;
-    //Render each list element
-    for (it = objectsList.begin(); it != objectsList.end(); it++)
-    {
-        if (counter == i)
-            return (*it);
-        counter++;
-    }
-    return NULL;
+    if (i < 0 || i >= (int)objects.size())
+        return NULL;
+    return objects.at(i);
 }
 
 /**
@@ -175,7 +688,7 @@ Eng::Node ENG_API* Eng::List::getObject(int i) {
 * @return The number of nodes in the list.
 */
 int ENG_API Eng::List::size() {
-    return objectsList.size();
+    return objects.size();
 }
 
 /**
@@ -187,22 +700,39 @@ int ENG_API Eng::List::size() {
 * @return Pointer to the node with the specified ID.
 */
 Eng::Node ENG_API* Eng::List::getObjectById(int id) {
-    std::list<Node*>::iterator it;
-    for (it = objectsList.begin(); it != objectsList.end(); it++)
-    {
-        if ((*it)->getId() == id)
-            return (*it);
-    }
-    return NULL;
+    return registry.get(registry.findById((unsigned int)id));
 }
 
 /**
-* @brief Get the list of objects
+* @brief Get an object from the list by name
 *
-* Gets the list of nodes.
+* Constant time lookup through the node registry.
 *
-* @return A list of pointers to the nodes.
+* @param name The name of the node to be retrieved.
+* @return Pointer to the node with the specified name, nullptr if not found.
 */
-std::list<Eng::Node*> ENG_API Eng::List::getObjectList() {
-    return this->objectsList;
-}
\ No newline at end of file
+Eng::Node ENG_API* Eng::List::getObjectByName(const std::string& name) {
+    return registry.get(registry.findByName(name));
+}
+
+/**
+* @brief Get the handle of a node by name
+*
+* The handle can be stored and resolved every frame with getObject(NodeHandle).
+*
+* @param name The name of the node.
+* @return The handle, null if no node has the name.
+*/
+Eng::NodeHandle ENG_API Eng::List::getHandle(const std::string& name) const {
+    return registry.findByName(name);
+}
+
+/**
+* @brief Get an object from the list by handle
+*
+* @param handle The node handle.
+* @return Pointer to the node, nullptr if the handle is stale (node removed or list cleared).
+*/
+Eng::Node ENG_API* Eng::List::getObject(NodeHandle handle) const {
+    return registry.get(handle);
+}
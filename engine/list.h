@@ -33,7 +33,7 @@ public:
     *
     * Initializes an empty list.
     */
-    List() {};
+    List() : Object(Eng::ObjectType::LIST) {};
 
     /**
     * @brief Add an entry (node) to the list
@@ -45,17 +45,197 @@ public:
     */
     void addEntry(Eng::Node* node);
 
+    /**
+    * @brief Add a scene loaded in an arena
+    *
+    * The list takes the ownership of the arena: the scene objects are released
+    * in bulk by clear().
+    *
+    * @param root Pointer to the root node of the scene.
+    * @param arena The arena owning the scene objects.
+    */
+    void addEntry(Eng::Node* root, Eng::SceneArena* arena);
+
+    /**
+    * @brief Attach a node (and its subtree) to a node already in the list
+    *
+    * Only the new nodes are registered: the cost does not depend on the scene size.
+    *
+    * @param parent The new parent.
+    * @param node The node to attach.
+    */
+    void addEntry(Eng::Node* parent, Eng::Node* node);
+
+    /**
+    * @brief Remove a node and its subtree from the list
+    *
+    * The node is detached from its parent (or from the roots). The nodes are not deleted.
+    *
+    * @param node The node to remove.
+    * @return False if the node is not in the list.
+    */
+    bool removeEntry(Eng::Node* node);
+
+    /**
+    * @brief Update the world matrices of all the scenes in the list
+    *
+    * Runs the top-down transform pass once per frame, before rendering.
+    * Only the dirty nodes recompute their world matrix and world bounds.
+    */
+    void updateWorldTransforms();
+
+    /**
+    * @brief Enable or disable the flat transform storage
+    *
+    * When enabled, the local and world matrices of all the nodes are kept in a
+    * TransformStore and updated with a single linear loop.
+    *
+    * @param enable True to use the flat storage.
+    */
+    void setFlatTransforms(bool enable);
+
+    /**
+    * @brief Set the number of threads of the update stage
+    *
+    * The children of the scene roots are independent subtrees and are updated in parallel.
+    *
+    * @param threads The number of threads, the render thread included (0 or 1 means serial).
+    */
+    void setUpdateThreads(unsigned int threads);
+
+    /**
+    * @brief Set the minimum scene size for the parallel update
+    *
+    * Smaller scenes are updated on the render thread only.
+    *
+    * @param nodes The minimum number of nodes.
+    */
+    void setParallelThreshold(unsigned int nodes) { parallelThreshold = nodes; }
+
     /**
     * @brief Remove the last entry from the list
     *
-    * Removes the last node from the list.
+    * Removes the last node of getObjectList() and its subtree, as removeEntry() does. Removals
+    * reorder the list: it is not the last node added. The node is not deleted.
     */
     void popEntry();
 
+    /**
+    * @brief Compute the visible objects of the frame
+    *
+    * Runs once per frame, after the world update: the scene hierarchy is culled against a single
+    * frustum enclosing all the views (both eyes), then the occluded objects are removed. The
+    * result is shared by every light pass and every view.
+    *
+    * @param viewProjections The View-Projection matrices of the views.
+    * @param count The number of views.
+    */
+    void updateVisibility(const glm::mat4* viewProjections, unsigned int count);
+
+    /**
+    * @brief Get the visible objects of the frame
+    *
+    * @return The objects that passed the last visibility stage.
+    */
+    std::span<Eng::Node* const> getVisibleObjects() const { return visibleObjects; }
+
+    /**
+    * @brief Enable or disable the occlusion stage
+    *
+    * When enabled, the objects hidden behind the largest static meshes are removed from the
+    * visible objects by a CPU depth buffer test.
+    *
+    * @param enable True to run the occlusion stage.
+    */
+    void setOcclusionCulling(bool enable) { occlusionCulling = enable; }
+
+    /**
+    * @brief Set the margin of the visibility cache
+    *
+    * The frustum stage culls against a frustum enlarged by the margin. While no node moves and
+    * the current views stay inside that frustum (small head motion), the cached result is reused.
+    *
+    * @param margin The margin in world units, 0 to test every frame.
+    */
+    void setVisibilityCacheMargin(float margin) { cacheMargin = margin; visibilityCached = false; }
+
+    /**
+    * @brief Check if the last visibility stage reused the cached frustum result
+    *
+    * @return True if the frustum tests were skipped.
+    */
+    bool isVisibilityReused() const { return visibilityReused; }
+
+    /**
+    * @brief Get the occlusion stage
+    *
+    * @return The occlusion culler, to tune its resolution and occluders.
+    */
+    Eng::OcclusionCuller& getOcclusionCuller() { return occlusionCuller; }
+
+    /**
+    * @brief Get the number of objects rejected by the last occlusion stage
+    *
+    * @return The number of occluded objects.
+    */
+    unsigned int getOccludedCount() const { return occlusionCulling ? occlusionCuller.getRejectedCount() : 0; }
+
+    /**
+    * @brief Get the objects lit by a light in the last visibility stage
+    *
+    * @param light The index of the light, in the order of the light passes.
+    * @return The visible objects inside the influence of the light.
+    */
+    std::span<Eng::Node* const> getLitObjects(unsigned int light) const;
+
+    /**
+    * @brief Set the default detail culling thresholds
+    *
+    * Used by the nodes without thresholds of their own. 0 disables the test (the default).
+    *
+    * @param minScreenSize The minimum projected diameter, as a fraction of the view height.
+    * @param maxDrawDistance The maximum view depth of the nearest point of the bounding sphere.
+    */
+    void setDetailCulling(float minScreenSize, float maxDrawDistance) { defaultMinScreenSize = minScreenSize; defaultMaxDrawDistance = maxDrawDistance; }
+
+    /**
+    * @brief Set the detail culling thresholds of a whole subtree
+    *
+    * Groups of props (e.g. the captured pieces) share their thresholds through their parent node.
+    *
+    * @param root The root of the subtree, included.
+    * @param minScreenSize The minimum projected diameter, negative for the default.
+    * @param maxDrawDistance The maximum draw distance, negative for the default.
+    */
+    void setDetailThresholds(Eng::Node* root, float minScreenSize, float maxDrawDistance);
+
+    /**
+    * @brief Get the number of objects dropped for their projected size by the last visibility stage
+    *
+    * @return The number of small objects skipped.
+    */
+    unsigned int getSmallCulledCount() const { return smallCulledCount; }
+
+    /**
+    * @brief Get the number of objects dropped for their distance by the last visibility stage
+    *
+    * @return The number of distant objects skipped.
+    */
+    unsigned int getDistanceCulledCount() const { return distanceCulledCount; }
+
+    /**
+    * @brief Get the state change counters of the frame
+    *
+    * Reset by updateVisibility(), summed over all the views and passes rendered since.
+    *
+    * @return The draws, binds and uniform uploads issued and saved by the render queue.
+    */
+    const Eng::RenderStats& getRenderStats() const { return renderQueue.getStats(); }
+
     /**
     * @brief Render the list
     *
-    * Renders the list using the given transformation matrix.
+    * Renders the visible objects using the given transformation matrix.
     *
     * @param transform The transformation matrix.
     * @param data A pointer to additional data.
@@ -66,7 +246,8 @@ public:
     /**
     * @brief Clear the list
     *
-    * Clears all nodes from the list.
+    * Clears all nodes from the list. Heap allocated nodes, lights and scene roots included, are deleted one by one,
+    * scene arenas are released in bulk.
     */
     void clear();
 
@@ -90,14 +271,42 @@ public:
     */
     Eng::Node* getObjectById(int id);
 
+    /**
+    * @brief Get an object from the list by name
+    *
+    * Constant time lookup through the node registry.
+    *
+    * @param name The name of the node to be retrieved.
+    * @return Pointer to the node with the specified name, nullptr if not found.
+    */
+    Eng::Node* getObjectByName(const std::string& name);
+
+    /**
+    * @brief Get the handle of a node by name
+    *
+    * The handle can be stored and resolved every frame with getObject(NodeHandle).
+    *
+    * @param name The name of the node.
+    * @return The handle, null if no node has the name.
+    */
+    Eng::NodeHandle getHandle(const std::string& name) const;
+
+    /**
+    * @brief Get an object from the list by handle
+    *
+    * @param handle The node handle.
+    * @return Pointer to the node, nullptr if the handle is stale (node removed or list cleared).
+    */
+    Eng::Node* getObject(Eng::NodeHandle handle) const;
+
     /**
     * @brief Get the list of objects
     *
-    * Gets the list of nodes.
+    * Gets a view of the nodes, invalidated by add and remove.
     *
-    * @return A list of pointers to the nodes.
+    * @return The nodes.
     */
-    std::list<Eng::Node*> getObjectList();
+    std::span<Eng::Node* const> getObjectList() const { return objects.view(); }
 
     /**
     * @brief Get the size of the list
@@ -127,18 +336,127 @@ public:
     /**
     * @brief Get the list of pickable objects
     *
-    * Get the list of pickable objects
+    * Get the set of pickable objects, kept up to date by add and remove.
+    *
+    * @return The set of pickable objects
+    */
+    const Eng::NodeSet& getPickableObjectsList() const { return pickables; };
+
+    /**
+    * @brief Get the spatial index of the pickable objects
+    *
+    * Refreshed by updateWorldTransforms() when objects move.
     *
-    * @return The list of pickable objects
+    * @return The pick grid
     */
-    std::list<Eng::Node*> getPickableObjectsList() { return pickableObjectsList; };
+    const Eng::PickGrid& getPickGrid() const { return pickGrid; };
 
     bool render(glm::mat4 transform, void* data) { return false; };
 
 private:
-    std::list<Eng::Node*> objectsList; /**< The list of nodes */
-    std::list<Eng::Node*> lightsList; /**< The list of lights */
-    std::list<Eng::Node*> pickableObjectsList; /**< The list of pickable objects */
+    /**
+    * @brief Add the subtree of a node to the list
+    *
+    * @param root Pointer to the root of the subtree.
+    * @param includeRoot True to add the root itself too.
+    */
+    void addSubtree(Eng::Node* root, bool includeRoot);
+
+    /**
+    * @brief Remove a node and its subtree from the collections
+    *
+    * @param root Pointer to the root of the subtree.
+    */
+    void removeSubtree(Eng::Node* root);
+
+    /**
+    * @brief Run the transform pass and the bounds refit
+    */
+    void updateHierarchy();
+
+    /**
+    * @brief Run the frustum stage
+    *
+    * The frustum enclosing all the views is enlarged by the cache margin and kept for the
+    * next frames.
+    *
+    * @param viewProjections The View-Projection matrices of the views.
+    * @param count The number of views.
+    */
+    void updateFrustumObjects(const glm::mat4* viewProjections, unsigned int count);
+
+    /**
+    * @brief Collect the visible objects of a subtree
+    *
+    * The subtree AABB is tested first: a subtree fully outside is skipped, a subtree
+    * fully inside is accepted without further tests. The other objects are queued for
+    * the batched sphere test.
+    *
+    * @param node The root of the subtree.
+    * @param frustum The culling frustum.
+    * @param planeMask The planes the parent crosses, the others are skipped (0 when fully inside).
+    */
+    void cullSubtree(Eng::Node* node, const Eng::Frustum& frustum, unsigned char planeMask);
+
+    /**
+    * @brief Split the visible objects by light
+    *
+    * Every light keeps the visible objects inside its influence (all of them for directional lights).
+    */
+    void updateLitObjects();
+
+    /**
+    * @brief Remove the visible objects below their detail thresholds
+    *
+    * @param viewProjections The View-Projection matrices of the views.
+    * @param count The number of views.
+    */
+    void cullDetail(const glm::mat4* viewProjections, unsigned int count);
+
+    /**
+    * @brief Get the screen rectangle of the influence of a light
+    *
+    * @param light The light.
+    * @param viewProjection The View-Projection matrix of the view.
+    * @param viewport The viewport: x, y, width and height.
+    * @param rect The rectangle, x, y, width and height in pixels.
+    * @return False if the influence is entirely off-screen.
+    */
+    static bool influenceRect(Eng::Light* light, const glm::mat4& viewProjection, const glm::ivec4& viewport, glm::ivec4& rect);
+
+    std::list<Eng::Node*> rootsList; /**< The list of scene roots */
+    Eng::NodeRegistry registry; /**< Lookup table by ID and by name */
+    Eng::TransformStore transformStore; /**< The flat transform storage */
+    bool flatTransforms = false; /**< Flat transform storage flag */
+    Eng::WorkerPool workerPool; /**< The threads of the update stage */
+    std::vector<Eng::Node*> updateTasks; /**< The subtrees updated in parallel */
+    unsigned int parallelThreshold = 1024; /**< Minimum number of nodes for the parallel update */
+    std::vector<Eng::SceneArena*> arenas; /**< The arenas of the loaded scenes */
+    Eng::NodeSet objects; /**< The renderable nodes */
+    Eng::NodeSet lights; /**< The lights */
+    Eng::NodeSet pickables; /**< The pickable objects */
+    Eng::PickGrid pickGrid; /**< The spatial index of the pickable objects */
+    std::vector<Eng::Node*> visibleObjects; /**< The output of the visibility stage */
+    std::vector<Eng::Node*> frustumObjects; /**< The output of the frustum stage, reused while valid */
+    Eng::Frustum cachedFrustum; /**< The enlarged frustum of the cached frustum stage */
+    float cacheMargin = 0.02f; /**< The enlargement of the cached frustum */
+    bool visibilityCached = false; /**< True when frustumObjects can be reused */
+    bool visibilityReused = false; /**< True if the last visibility stage reused the cache */
+    bool boundsChanged = true; /**< True when a node moved since the last visibility stage */
+    std::vector<Eng::Node*> cullCandidates; /**< The objects left to the batched sphere test */
+    Eng::SphereArrays candidateSpheres; /**< The world bounding spheres of the candidates */
+    std::vector<unsigned int> candidateMask; /**< The visibility bitmask of the candidates */
+    Eng::OcclusionCuller occlusionCuller; /**< The occlusion stage */
+    bool occlusionCulling = true; /**< True to run the occlusion stage */
+    std::vector<Eng::Node*> litObjects; /**< The visible objects of every light, one range per light */
+    std::vector<unsigned int> litRanges; /**< The start of the range of every light in litObjects, plus the end */
+    float defaultMinScreenSize = 0.0f; /**< The minimum projected size of the nodes without their own */
+    float defaultMaxDrawDistance = 0.0f; /**< The maximum draw distance of the nodes without their own */
+    unsigned int smallCulledCount = 0; /**< Objects dropped for their size by the last visibility stage */
+    unsigned int distanceCulledCount = 0; /**< Objects dropped for their distance by the last visibility stage */
+    Eng::RenderQueue renderQueue; /**< The sorted draws of the view being rendered */
+    std::vector<LightBlock> lightBlocks; /**< The uniform blocks of the lights, per pass */
+    bool lightBlocksDirty = true; /**< True if the light blocks must be uploaded before rendering */
 };
 
 #endif // LIST_H
\ No newline at end of file
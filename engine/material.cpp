@@ -26,7 +26,7 @@
 *
 * Initializes a material with default values.
 */
-Eng::Material::Material()
+Eng::Material::Material() : Object(ObjectType::MATERIAL)
 {
 	Object::setId(Object::getNextId());
 	Object::setName("default");
@@ -49,7 +49,7 @@ Eng::Material::Material()
 * @param _specular The specular color of the material.
 * @param _shininess The shininess of the material.
 */
-Eng::Material::Material(const std::string name, glm::vec3 _emission, glm::vec3 _ambient, glm::vec3 _diffuse, glm::vec3 _specular, float _shininess) {
+Eng::Material::Material(const std::string name, glm::vec3 _emission, glm::vec3 _ambient, glm::vec3 _diffuse, glm::vec3 _specular, float _shininess) : Object(ObjectType::MATERIAL) {
 	Object::setId(Object::getNextId());
 	Object::setName(name);
 	this->setEmission(_emission);
@@ -127,6 +127,7 @@ Eng::Texture* Eng::Material::getTexture() {
 */
 void ENG_API Eng::Material::setEmission(glm::vec3 emission) {
 	this->emission = emission;
+	blockSlot = -1;
 }
 
 /**
@@ -136,6 +137,7 @@ void ENG_API Eng::Material::setEmission(glm::vec3 emission) {
 */
 void ENG_API Eng::Material::setAmbient(glm::vec3 ambient) {
 	this->ambient = ambient;
+	blockSlot = -1;
 }
 
 /**
@@ -145,6 +147,7 @@ void ENG_API Eng::Material::setAmbient(glm::vec3 ambient) {
 */
 void ENG_API Eng::Material::setDiffuse(glm::vec3 diffuse) {
 	this->diffuse = diffuse;
+	blockSlot = -1;
 }
 
 /**
@@ -154,6 +157,7 @@ void ENG_API Eng::Material::setDiffuse(glm::vec3 diffuse) {
 */
 void ENG_API Eng::Material::setSpecular(glm::vec3 specular) {
 	this->specular = specular;
+	blockSlot = -1;
 }
 
 /**
@@ -163,6 +167,7 @@ void ENG_API Eng::Material::setSpecular(glm::vec3 specular) {
 */
 void ENG_API Eng::Material::setShininess(float shininess) {
 	this->shininess = shininess;
+	blockSlot = -1;
 }
 
 /**
@@ -174,6 +179,31 @@ void ENG_API Eng::Material::setTexture(Eng::Texture* texture) {
 	this->texture = texture;
 }
 
+/**
+* @brief Upload the material block
+*
+* The copies of the material share the slot.
+*/
+void ENG_API Eng::Material::upload() {
+	MaterialBlock block;
+	block.ambient = glm::vec4(ambient, 1.0f);
+	block.diffuse = glm::vec4(diffuse, 1.0f);
+	block.specular = glm::vec4(specular, shininess);
+	block.emission = glm::vec4(emission, 1.0f);
+	blockSlot = (int)UniformBuffers::addMaterial(block);
+}
+
+/**
+* @brief Get the slot of the material block
+*
+* @return The slot in the material uniform buffer.
+*/
+unsigned int ENG_API Eng::Material::getBlockSlot() {
+	if (blockSlot < 0)
+		upload();
+	return (unsigned int)blockSlot;
+}
+
 /**
 * @brief Render the material
 * 
@@ -185,9 +215,6 @@ bool ENG_API Eng::Material::render(glm::mat4 matrix, void* ptr) {
 
 	if (texture != nullptr)
 		texture->render(matrix, ptr);
-	Shader::getCurrentShader()->setVec3("matAmbient", this->ambient);
-	Shader::getCurrentShader()->setVec3("matDiffuse", this->diffuse);
-	Shader::getCurrentShader()->setVec3("matSpecular", this->specular);
-	Shader::getCurrentShader()->setFloat("matShininess", this->shininess);
+	UniformBuffers::bindMaterial(getBlockSlot());
 	return true;
 }
\ No newline at end of file
@@ -141,6 +141,24 @@ public:
     */
     Eng::Texture* getTexture();
 
+    /**
+    * @brief Upload the material block
+    *
+    * Called at load: the material gets the slot of its colors in the material uniform buffer.
+    * The copies of the material share the slot. Changing a color detaches the slot, the next
+    * upload finds or adds the new colors.
+    */
+    void upload();
+
+    /**
+    * @brief Get the slot of the material block
+    *
+    * Uploads the block first if the material has no slot.
+    *
+    * @return The slot in the material uniform buffer.
+    */
+    unsigned int getBlockSlot();
+
     /**
     * @brief Render the material
     *
@@ -158,7 +176,8 @@ private:
     glm::vec3 diffuse;      /**< The diffuse color of the material */
     glm::vec3 specular;     /**< The specular color of the material */
     float shininess;        /**< The shininess of the material */
-    Eng::Texture* texture;  /**< Pointer to the texture of the material */
+    Eng::Texture* texture = nullptr;  /**< Pointer to the texture of the material */
+    int blockSlot = -1;     /**< The slot of the material block, -1 if not uploaded */
 };
 
 #endif // MATERIAL_H
\ No newline at end of file
@@ -0,0 +1,292 @@
+/**
+* @file mathKernels.cpp
+* @brief Implementation of the MathKernels class
+*
+* This file contains the implementation of the MathKernels class methods.
+*
+* @see MathKernels
+* @see mathKernels.h
+*
+* @date 2025
+*
+* @details Kernels are selected at compile time: AVX when the compiler targets it, SSE on any x64 build,
+* plain scalar code otherwise. All the routines accept unaligned glm matrices.
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+#include "engine.h"
+
+#if defined(__AVX__)
+#define ENG_MATH_AVX
+#define ENG_MATH_SSE
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENG_MATH_SSE
+#include <emmintrin.h>
+#endif
+
+#ifdef ENG_MATH_SSE
+/**
+* @brief Cross product of two xyz vectors stored in SSE registers (w is zero).
+*/
+static inline __m128 cross3(__m128 a, __m128 b) {
+   __m128 aYzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+   __m128 bYzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+   __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYzx), _mm_mul_ps(aYzx, b));
+   return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+#endif
+
+/**
+* @brief Multiply two matrices
+*
+* Computes out = a * b. The output may alias one of the inputs.
+*
+* @param a The left matrix.
+* @param b The right matrix.
+* @param out The result.
+*/
+void ENG_API Eng::MathKernels::multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& out) {
+#ifdef ENG_MATH_SSE
+   const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+   const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+   const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+   const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+
+   for (int c = 0; c < 4; c++) {
+      const __m128 col = _mm_loadu_ps(&b[c][0]);
+      __m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(col, col, _MM_SHUFFLE(0, 0, 0, 0)));
+      r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_shuffle_ps(col, col, _MM_SHUFFLE(1, 1, 1, 1))));
+      r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_shuffle_ps(col, col, _MM_SHUFFLE(2, 2, 2, 2))));
+      r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_shuffle_ps(col, col, _MM_SHUFFLE(3, 3, 3, 3))));
+      _mm_storeu_ps(&out[c][0], r);
+   }
+#else
+   out = a * b;
+#endif
+}
+
+/**
+* @brief Multiply two arrays of matrices
+*
+* Computes out[i] = a[i] * b[i] for every i.
+*
+* @param a The left matrices.
+* @param b The right matrices.
+* @param out The results.
+* @param count The number of matrices.
+*/
+void ENG_API Eng::MathKernels::multiplyBatch(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, unsigned int count) {
+#ifdef ENG_MATH_AVX
+   for (unsigned int i = 0; i < count; i++) {
+      // Every column of a is duplicated in both 128 bit lanes, two columns of b are processed at once:
+      const float* pa = &a[i][0][0];
+      const __m128 a0 = _mm_loadu_ps(pa), a1 = _mm_loadu_ps(pa + 4), a2 = _mm_loadu_ps(pa + 8), a3 = _mm_loadu_ps(pa + 12);
+      const __m256 aa0 = _mm256_insertf128_ps(_mm256_castps128_ps256(a0), a0, 1);
+      const __m256 aa1 = _mm256_insertf128_ps(_mm256_castps128_ps256(a1), a1, 1);
+      const __m256 aa2 = _mm256_insertf128_ps(_mm256_castps128_ps256(a2), a2, 1);
+      const __m256 aa3 = _mm256_insertf128_ps(_mm256_castps128_ps256(a3), a3, 1);
+
+      const float* pb = &b[i][0][0];
+      float* po = &out[i][0][0];
+      for (int c = 0; c < 16; c += 8) {
+         const __m256 cols = _mm256_loadu_ps(pb + c);
+         __m256 r = _mm256_mul_ps(aa0, _mm256_shuffle_ps(cols, cols, _MM_SHUFFLE(0, 0, 0, 0)));
+         r = _mm256_add_ps(r, _mm256_mul_ps(aa1, _mm256_shuffle_ps(cols, cols, _MM_SHUFFLE(1, 1, 1, 1))));
+         r = _mm256_add_ps(r, _mm256_mul_ps(aa2, _mm256_shuffle_ps(cols, cols, _MM_SHUFFLE(2, 2, 2, 2))));
+         r = _mm256_add_ps(r, _mm256_mul_ps(aa3, _mm256_shuffle_ps(cols, cols, _MM_SHUFFLE(3, 3, 3, 3))));
+         _mm256_storeu_ps(po + c, r);
+      }
+   }
+#else
+   for (unsigned int i = 0; i < count; i++)
+      multiply(a[i], b[i], out[i]);
+#endif
+}
+
+/**
+* @brief Invert a rigid transform
+*
+* Valid only for rotation + translation matrices (cameras, HMD and eye poses):
+* the inverse is the transposed rotation and the rotated, negated translation.
+*
+* @param m The rigid transform.
+* @return The inverse transform.
+*/
+glm::mat4 ENG_API Eng::MathKernels::rigidInverse(const glm::mat4& m) {
+   glm::mat4 r;
+#ifdef ENG_MATH_SSE
+   const __m128 wMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+   __m128 c0 = _mm_and_ps(_mm_loadu_ps(&m[0][0]), wMask);
+   __m128 c1 = _mm_and_ps(_mm_loadu_ps(&m[1][0]), wMask);
+   __m128 c2 = _mm_and_ps(_mm_loadu_ps(&m[2][0]), wMask);
+   __m128 c3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+   const __m128 t = _mm_loadu_ps(&m[3][0]);
+
+   // Transposed rotation (the last column stays [0, 0, 0, 1]):
+   _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+   // Translation: -R^T * t
+   __m128 nt = _mm_mul_ps(c0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0)));
+   nt = _mm_add_ps(nt, _mm_mul_ps(c1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+   nt = _mm_add_ps(nt, _mm_mul_ps(c2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2))));
+
+   _mm_storeu_ps(&r[0][0], c0);
+   _mm_storeu_ps(&r[1][0], c1);
+   _mm_storeu_ps(&r[2][0], c2);
+   _mm_storeu_ps(&r[3][0], _mm_sub_ps(c3, nt));
+#else
+   const glm::mat3 rt = glm::transpose(glm::mat3(m));
+   r = glm::mat4(rt);
+   r[3] = glm::vec4(-(rt * glm::vec3(m[3])), 1.0f);
+#endif
+   return r;
+}
+
+/**
+* @brief Invert an array of rigid transforms
+*
+* @param m The rigid transforms.
+* @param out The inverse transforms.
+* @param count The number of matrices.
+*/
+void ENG_API Eng::MathKernels::rigidInverseBatch(const glm::mat4* m, glm::mat4* out, unsigned int count) {
+   for (unsigned int i = 0; i < count; i++)
+      out[i] = rigidInverse(m[i]);
+}
+
+/**
+* @brief Derive the normal matrix of a modelview matrix
+*
+* Equivalent to glm::inverseTranspose(glm::mat3(m)), computed with the cofactors of the upper 3x3.
+*
+* @param m The modelview matrix.
+* @return The normal matrix.
+*/
+glm::mat3 ENG_API Eng::MathKernels::normalMatrix(const glm::mat4& m) {
+#ifdef ENG_MATH_SSE
+   const __m128 wMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+   const __m128 a = _mm_and_ps(_mm_loadu_ps(&m[0][0]), wMask);
+   const __m128 b = _mm_and_ps(_mm_loadu_ps(&m[1][0]), wMask);
+   const __m128 c = _mm_and_ps(_mm_loadu_ps(&m[2][0]), wMask);
+
+   const __m128 bc = cross3(b, c);
+   const __m128 ca = cross3(c, a);
+   const __m128 ab = cross3(a, b);
+
+   // Determinant = a . (b x c):
+   __m128 d = _mm_mul_ps(a, bc);
+   d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+   d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 0, 3, 2)));
+   const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), d);
+
+   float cols[12];
+   _mm_storeu_ps(cols, _mm_mul_ps(bc, invDet));
+   _mm_storeu_ps(cols + 4, _mm_mul_ps(ca, invDet));
+   _mm_storeu_ps(cols + 8, _mm_mul_ps(ab, invDet));
+   return glm::mat3(cols[0], cols[1], cols[2], cols[4], cols[5], cols[6], cols[8], cols[9], cols[10]);
+#else
+   const glm::vec3 a(m[0]), b(m[1]), c(m[2]);
+   const glm::vec3 bc = glm::cross(b, c);
+   const float invDet = 1.0f / glm::dot(a, bc);
+   return glm::mat3(bc * invDet, glm::cross(c, a) * invDet, glm::cross(a, b) * invDet);
+#endif
+}
+
+/**
+* @brief Test an array of spheres against six planes
+*
+* The spheres are stored as structure of arrays and tested 8 (AVX) or 4 (SSE) at a time.
+* A sphere is visible when no plane has it fully on its negative side.
+* Bit i % 32 of mask[i / 32] is set when sphere i is visible; the mask must hold
+* (count + 31) / 32 words.
+*
+* @param planes The planes as (normal, d), normals pointing inside.
+* @param x The sphere center x coordinates.
+* @param y The sphere center y coordinates.
+* @param z The sphere center z coordinates.
+* @param radius The sphere radii.
+* @param count The number of spheres.
+* @param mask The visibility bitmask.
+*/
+void ENG_API Eng::MathKernels::spheresInPlanes(const glm::vec4 planes[6], const float* x, const float* y, const float* z,
+   const float* radius, unsigned int count, unsigned int* mask) {
+   std::fill(mask, mask + (count + 31) / 32, 0u);
+   unsigned int i = 0;
+
+#if defined(ENG_MATH_AVX)
+   __m256 nx[6], ny[6], nz[6], nd[6];
+   for (int p = 0; p < 6; p++) {
+      nx[p] = _mm256_set1_ps(planes[p].x);
+      ny[p] = _mm256_set1_ps(planes[p].y);
+      nz[p] = _mm256_set1_ps(planes[p].z);
+      nd[p] = _mm256_set1_ps(planes[p].w);
+   }
+   const __m256 zero = _mm256_setzero_ps();
+   for (; i + 8 <= count; i += 8) {
+      const __m256 cx = _mm256_loadu_ps(x + i);
+      const __m256 cy = _mm256_loadu_ps(y + i);
+      const __m256 cz = _mm256_loadu_ps(z + i);
+      const __m256 negRadius = _mm256_sub_ps(zero, _mm256_loadu_ps(radius + i));
+      __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+      for (int p = 0; p < 6; p++) {
+         __m256 distance = _mm256_add_ps(_mm256_mul_ps(nx[p], cx), nd[p]);
+         distance = _mm256_add_ps(distance, _mm256_mul_ps(ny[p], cy));
+         distance = _mm256_add_ps(distance, _mm256_mul_ps(nz[p], cz));
+         inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+      }
+      mask[i / 32] |= (unsigned int)_mm256_movemask_ps(inside) << (i % 32);
+   }
+#elif defined(ENG_MATH_SSE)
+   __m128 nx[6], ny[6], nz[6], nd[6];
+   for (int p = 0; p < 6; p++) {
+      nx[p] = _mm_set1_ps(planes[p].x);
+      ny[p] = _mm_set1_ps(planes[p].y);
+      nz[p] = _mm_set1_ps(planes[p].z);
+      nd[p] = _mm_set1_ps(planes[p].w);
+   }
+   const __m128 zero = _mm_setzero_ps();
+   for (; i + 4 <= count; i += 4) {
+      const __m128 cx = _mm_loadu_ps(x + i);
+      const __m128 cy = _mm_loadu_ps(y + i);
+      const __m128 cz = _mm_loadu_ps(z + i);
+      const __m128 negRadius = _mm_sub_ps(zero, _mm_loadu_ps(radius + i));
+      __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+      for (int p = 0; p < 6; p++) {
+         __m128 distance = _mm_add_ps(_mm_mul_ps(nx[p], cx), nd[p]);
+         distance = _mm_add_ps(distance, _mm_mul_ps(ny[p], cy));
+         distance = _mm_add_ps(distance, _mm_mul_ps(nz[p], cz));
+         inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+      }
+      mask[i / 32] |= (unsigned int)_mm_movemask_ps(inside) << (i % 32);
+   }
+#endif
+
+   // Scalar fallback and tail:
+   for (; i < count; i++) {
+      bool inside = true;
+      for (int p = 0; p < 6 && inside; p++)
+         inside = planes[p].x * x[i] + planes[p].w + planes[p].y * y[i] + planes[p].z * z[i] >= -radius[i];
+      if (inside)
+         mask[i / 32] |= 1u << (i % 32);
+   }
+}
+
+/**
+* @brief Get the name of the compiled kernel set
+*
+* @return "AVX", "SSE" or "scalar".
+*/
+const char ENG_API* Eng::MathKernels::getInstructionSet() {
+#if defined(ENG_MATH_AVX)
+   return "AVX";
+#elif defined(ENG_MATH_SSE)
+   return "SSE";
+#else
+   return "scalar";
+#endif
+}
@@ -0,0 +1,115 @@
+/**
+* @file mathKernels.h
+* @brief MathKernels class header file
+*
+* This file contains the definition of the MathKernels class, the vectorized matrix routines: world matrix
+* composition, camera inversion, normal matrix derivation and sphere culling.
+*
+* @date 2025
+*
+* @details Kernels are selected at compile time: AVX when the compiler targets it, SSE on any x64 build,
+* plain scalar code otherwise. All the routines accept unaligned glm matrices.
+* The call sites use a kernel only where Benchmark::matrices() shows a win over the inlined glm code: the
+* single multiply and the normal matrix are not faster, the per-node and per-draw paths keep glm.
+* @see Eng::Camera, Eng::Frustum, Eng::Benchmark
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+
+#ifndef MATH_KERNELS_H
+#define MATH_KERNELS_H
+
+#include "engine.h"
+
+/**
+* @brief MathKernels class
+*
+* Static SIMD matrix kernels with a scalar fallback.
+*/
+class ENG_API MathKernels {
+public:
+   /**
+   * @brief Multiply two matrices
+   *
+   * Computes out = a * b. The output may alias one of the inputs.
+   *
+   * @param a The left matrix.
+   * @param b The right matrix.
+   * @param out The result.
+   */
+   static void multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& out);
+
+   /**
+   * @brief Multiply two arrays of matrices
+   *
+   * Computes out[i] = a[i] * b[i] for every i.
+   *
+   * @param a The left matrices.
+   * @param b The right matrices.
+   * @param out The results.
+   * @param count The number of matrices.
+   */
+   static void multiplyBatch(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, unsigned int count);
+
+   /**
+   * @brief Invert a rigid transform
+   *
+   * Valid only for rotation + translation matrices (cameras, HMD and eye poses):
+   * the inverse is the transposed rotation and the rotated, negated translation.
+   *
+   * @param m The rigid transform.
+   * @return The inverse transform.
+   */
+   static glm::mat4 rigidInverse(const glm::mat4& m);
+
+   /**
+   * @brief Invert an array of rigid transforms
+   *
+   * @param m The rigid transforms.
+   * @param out The inverse transforms.
+   * @param count The number of matrices.
+   */
+   static void rigidInverseBatch(const glm::mat4* m, glm::mat4* out, unsigned int count);
+
+   /**
+   * @brief Derive the normal matrix of a modelview matrix
+   *
+   * Equivalent to glm::inverseTranspose(glm::mat3(m)), computed with the cofactors of the upper 3x3.
+   *
+   * @param m The modelview matrix.
+   * @return The normal matrix.
+   */
+   static glm::mat3 normalMatrix(const glm::mat4& m);
+
+   /**
+   * @brief Test an array of spheres against six planes
+   *
+   * The spheres are stored as structure of arrays and tested 8 (AVX) or 4 (SSE) at a time.
+   * A sphere is visible when no plane has it fully on its negative side.
+   * Bit i % 32 of mask[i / 32] is set when sphere i is visible; the mask must hold
+   * (count + 31) / 32 words.
+   *
+   * @param planes The planes as (normal, d), normals pointing inside.
+   * @param x The sphere center x coordinates.
+   * @param y The sphere center y coordinates.
+   * @param z The sphere center z coordinates.
+   * @param radius The sphere radii.
+   * @param count The number of spheres.
+   * @param mask The visibility bitmask.
+   */
+   static void spheresInPlanes(const glm::vec4 planes[6], const float* x, const float* y, const float* z,
+      const float* radius, unsigned int count, unsigned int* mask);
+
+   /**
+   * @brief Get the name of the compiled kernel set
+   *
+   * @return "AVX", "SSE" or "scalar".
+   */
+   static const char* getInstructionSet();
+};
+
+#endif // MATH_KERNELS_H
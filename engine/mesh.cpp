@@ -30,7 +30,7 @@
 * @param name The name of the mesh.
 * @param material The material of the mesh.
 */
-Eng::Mesh::Mesh(std::string name, Material material) : Node(name) {
+Eng::Mesh::Mesh(std::string name, Material material) : Node(name, ObjectType::MESH) {
    this->material = material;
    glGenVertexArrays(1, &vao);
    glGenBuffers(1, &vertexVBO);
@@ -45,7 +45,7 @@ Eng::Mesh::Mesh(std::string name, Material material) : Node(name) {
 * Destroys the mesh object.
 */
 Eng::Mesh::~Mesh() {
-   glDeleteVertexArrays(1, &vao);
+   GlState::deleteVertexArray(vao);
    glDeleteBuffers(1, &vertexVBO);
    glDeleteBuffers(1, &normalsVBO);
    glDeleteBuffers(1, &texCoordVBO);
@@ -64,12 +64,12 @@ Eng::Mesh::~Mesh() {
 bool ENG_API Eng::Mesh::render(glm::mat4 matrix, void* ptr) { 
    material.render(matrix, ptr);
 
-   Shader::getCurrentShader()->setMatrix("modelview", matrix);
-   Shader::getCurrentShader()->setMatrix3("normalMatrix", glm::inverseTranspose(glm::mat3(matrix)));
+   Shader::getCurrentShader()->setMatrix(Shader::UNIFORM_MODELVIEW, matrix);
+   Shader::getCurrentShader()->setMatrix3(Shader::UNIFORM_NORMAL_MATRIX, glm::inverseTranspose(glm::mat3(matrix)));
 
-   glBindVertexArray(vao);
+   GlState::bindVertexArray(vao);
    glDrawElements(GL_TRIANGLES, facesCount, GL_UNSIGNED_INT, nullptr);
-   glBindVertexArray(0);
+   GlState::bindVertexArray(0);
 
    return true;
 }
@@ -139,7 +139,7 @@ void Eng::Mesh::setFaces(std::vector<unsigned int> faces) {
     *
     */
 void Eng::Mesh::setupMesh() {
-   glBindVertexArray(vao);
+   GlState::bindVertexArray(vao);
 
    glBindBuffer(GL_ARRAY_BUFFER, vertexVBO);
    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), vertices.data(), GL_STATIC_DRAW);
@@ -162,7 +162,46 @@ void Eng::Mesh::setupMesh() {
    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, facesVBO);
    glBufferData(GL_ELEMENT_ARRAY_BUFFER, faces.size() * sizeof(unsigned int), faces.data(), GL_STATIC_DRAW);
 
-   glBindVertexArray(0);
+   GlState::bindVertexArray(0);
    this->facesCount = faces.size();
 }
 
+
+/**
+    * @brief Set the bounding box of the mesh.
+    *
+    * The bounding sphere is moved to the center of the box. Its radius becomes the smallest
+    * of the half diagonal and of the radius set by setSphereRadius() (centered in the origin),
+    * so the box must be set after the radius.
+    *
+    * @param min The minimum corner in the mesh space.
+    * @param max The maximum corner in the mesh space.
+    */
+void Eng::Mesh::setBoundingBox(const glm::vec3& min, const glm::vec3& max) {
+   boxMin = min;
+   boxMax = max;
+   hasBox = true;
+
+   sphereCenter = (min + max) * 0.5f;
+   const float halfDiagonal = glm::length(max - min) * 0.5f;
+   if (sphereRadius > 0.0f)
+      sphereRadius = std::min(halfDiagonal, sphereRadius + glm::length(sphereCenter));
+   else
+      sphereRadius = halfDiagonal;
+   setDirty();
+}
+
+/**
+    * @brief Get the bounding box of the mesh.
+    *
+    * @param min The minimum corner in the mesh space.
+    * @param max The maximum corner in the mesh space.
+    * @return False if no box was set.
+    */
+bool Eng::Mesh::getBoundingBox(glm::vec3& min, glm::vec3& max) const {
+   if (!hasBox)
+      return false;
+   min = boxMin;
+   max = boxMax;
+   return true;
+}
@@ -120,6 +120,20 @@ public:
     */
     void setupMesh();
 
+    /**
+    * @brief Get the vertices of the mesh.
+    *
+    * @return The vertices (highest LOD), in the mesh space.
+    */
+    const std::vector<glm::vec3>& getVertices() const { return vertices; }
+
+    /**
+    * @brief Get the faces of the mesh.
+    *
+    * @return The vertex indices, three per triangle.
+    */
+    const std::vector<unsigned int>& getFaces() const { return faces; }
+
     /**
     * @brief Set the sphere bounding radius the mesh.
     *
@@ -137,6 +151,48 @@ public:
     */
     float getBoundingSphereRadius() const override { return sphereRadius; };
 
+    /**
+    * @brief Set the bounding box of the mesh.
+    *
+    * The bounding sphere is moved to the center of the box. Its radius becomes the smallest
+    * of the half diagonal and of the radius set by setSphereRadius() (centered in the origin),
+    * so the box must be set after the radius.
+    *
+    * @param min The minimum corner in the mesh space.
+    * @param max The maximum corner in the mesh space.
+    */
+    void setBoundingBox(const glm::vec3& min, const glm::vec3& max);
+
+    /**
+    * @brief Get the bounding sphere center of the mesh.
+    *
+    * @return Bounding sphere center in the mesh space.
+    */
+    glm::vec3 getBoundingSphereCenter() const override { return sphereCenter; };
+
+    /**
+    * @brief Get the bounding box of the mesh.
+    *
+    * @param min The minimum corner in the mesh space.
+    * @param max The maximum corner in the mesh space.
+    * @return False if no box was set.
+    */
+    bool getBoundingBox(glm::vec3& min, glm::vec3& max) const override;
+
+    /**
+    * @brief Get the vertex array object of the mesh.
+    *
+    * @return The OpenGL VAO.
+    */
+    unsigned int getVao() const { return vao; }
+
+    /**
+    * @brief Get the number of indices drawn by the mesh.
+    *
+    * @return The index count passed to glDrawElements.
+    */
+    unsigned int getFacesCount() const { return facesCount; }
+
 protected:
     int lod = 0; /**< The level of detail (LOD) of the mesh */
 
@@ -150,6 +206,9 @@ private:
     unsigned int facesCount; /**< Number of faces in the mesh */
 
     float sphereRadius = 0; /**< The radius of the bounding sphere of the mesh */
+    glm::vec3 sphereCenter = glm::vec3(0.0f); /**< The center of the bounding sphere of the mesh */
+    glm::vec3 boxMin = glm::vec3(0.0f), boxMax = glm::vec3(0.0f); /**< The bounding box of the mesh */
+    bool hasBox = false; /**< True when the bounding box is set */
 };
 
 #endif // MESH_H
\ No newline at end of file
@@ -28,15 +28,14 @@
  * Initializes the Node.
  *
  * @param name The node name
+ * @param type The object type tag, set by the derived classes
  */
-Eng::Node::Node(std::string name) {
+Eng::Node::Node(std::string name, ObjectType type) : Object(type) {
 	Object::setId(Object::getNextId());
 	Object::setName(name);
 	this->setParent(nullptr);
 	this->isDirty = true;
-	if (name.starts_with("p_"))
-		this->isGrabbable = true;
-	scale = 1.0f;
+	this->isGrabbable = name.starts_with("p_");
 }
 
 /**
@@ -55,7 +54,10 @@ Eng::Node::~Node() {}
  */
 bool ENG_API Eng::Node::addChild(Node* nodeToAdd) {
 	nodeToAdd->setParent(this);
+	nodeToAdd->setDirty();
 	children.push_back(nodeToAdd);
+	if (store != nullptr)
+		store->invalidate();
 	return true;
 }
 
@@ -74,6 +76,7 @@ bool ENG_API Eng::Node::removeChild(Node* nodeToRemove) {
 
 		// Erase the node from the vector
 		children.erase(child);
+		markBoundsDirty();
 		return true;
 	}
 	return false;
@@ -85,7 +88,7 @@ bool ENG_API Eng::Node::removeChild(Node* nodeToRemove) {
  *
  * @return The list of children.
  */
-std::vector<Eng::Node*> ENG_API Eng::Node::getChildren() {
+const std::vector<Eng::Node*> ENG_API& Eng::Node::getChildren() const {
 	return children;
 }
 
@@ -138,20 +141,148 @@ bool ENG_API Eng::Node::render(glm::mat4 mat, void* attr) {
  */
 void ENG_API Eng::Node::setScale(float scale)
 {
-	this->scale = scale;
+	setLocalScale(glm::vec3(scale));
 }
 
 /**
  * @brief Get the node scale.
  *
  *
- * @return The scale.
+ * @return The scale along the local x axis.
  */
 float Eng::Node::getScale() const
 {
+	return trsMode ? localScale.x : glm::length(glm::vec3(transform[0]));
+}
+
+/**
+ * @brief Set the local position.
+ *
+ * Only the translation of the local matrix changes: nothing is decomposed or recomposed.
+ *
+ * @param position The position in the parent space.
+ */
+void ENG_API Eng::Node::setLocalPosition(const glm::vec3& position) {
+	transform[3] = glm::vec4(position, 1.0f);
+	transformChanged();
+}
+
+/**
+ * @brief Set the local rotation.
+ *
+ * Switches the node to TRS mode (the current matrix is decomposed once).
+ * The local matrix is recomposed lazily.
+ *
+ * @param rotation The rotation.
+ */
+void ENG_API Eng::Node::setLocalRotation(const glm::quat& rotation) {
+	enableTRS();
+	localRotation = rotation;
+	localDirty = true;
+	transformChanged();
+}
+
+/**
+ * @brief Set the local scale.
+ *
+ * Switches the node to TRS mode (the current matrix is decomposed once).
+ * The local matrix is recomposed lazily.
+ *
+ * @param scale The scale along the local axes.
+ */
+void ENG_API Eng::Node::setLocalScale(const glm::vec3& scale) {
+	enableTRS();
+	localScale = scale;
+	localDirty = true;
+	transformChanged();
+}
+
+/**
+ * @brief Get the local position.
+ *
+ * @return The position in the parent space.
+ */
+glm::vec3 ENG_API Eng::Node::getLocalPosition() const {
+	return glm::vec3(transform[3]);
+}
+
+/**
+ * @brief Get the local rotation.
+ *
+ * Outside TRS mode the local matrix is decomposed into a temporary: the mode does not change.
+ *
+ * @return The rotation.
+ */
+glm::quat ENG_API Eng::Node::getLocalRotation() const {
+	if (trsMode)
+		return localRotation;
+	glm::quat rotation;
+	glm::vec3 scale;
+	decompose(rotation, scale);
+	return rotation;
+}
+
+/**
+ * @brief Get the local scale.
+ *
+ * Outside TRS mode the local matrix is decomposed into a temporary: the mode does not change.
+ *
+ * @return The scale along the local axes.
+ */
+glm::vec3 ENG_API Eng::Node::getLocalScale() const {
+	if (trsMode)
+		return localScale;
+	glm::quat rotation;
+	glm::vec3 scale;
+	decompose(rotation, scale);
 	return scale;
 }
 
+/**
+ * @brief Switch to TRS mode, decomposing the current local matrix.
+ */
+void Eng::Node::enableTRS() {
+	if (trsMode)
+		return;
+
+	decompose(localRotation, localScale);
+	trsMode = true;
+}
+
+/**
+ * @brief Decompose the local matrix into rotation and scale.
+ *
+ * A mirrored basis is folded into a negative x scale.
+ *
+ * @param rotation The rotation.
+ * @param scale The scale along the local axes.
+ */
+void Eng::Node::decompose(glm::quat& rotation, glm::vec3& scale) const {
+	glm::vec3 axes[3] = { glm::vec3(transform[0]), glm::vec3(transform[1]), glm::vec3(transform[2]) };
+	scale = glm::vec3(glm::length(axes[0]), glm::length(axes[1]), glm::length(axes[2]));
+	if (glm::dot(axes[0], glm::cross(axes[1], axes[2])) < 0.0f)
+		scale.x = -scale.x;
+
+	for (int i = 0; i < 3; i++)
+		if (scale[i] != 0.0f)
+			axes[i] /= scale[i];
+	rotation = glm::quat_cast(glm::mat3(axes[0], axes[1], axes[2]));
+}
+
+/**
+ * @brief Recompose the local matrix from the TRS components if they changed.
+ */
+void Eng::Node::composeLocal() const {
+	if (!localDirty)
+		return;
+
+	const glm::mat3 rotation = glm::mat3_cast(localRotation);
+	transform[0] = glm::vec4(rotation[0] * localScale.x, 0.0f);
+	transform[1] = glm::vec4(rotation[1] * localScale.y, 0.0f);
+	transform[2] = glm::vec4(rotation[2] * localScale.z, 0.0f);
+	localDirty = false;
+}
+
 /**
  * @brief Get the node transform.
  *
@@ -159,6 +290,7 @@ float Eng::Node::getScale() const
  */
 glm::mat4 ENG_API Eng::Node::getTransform() const
 {
+	composeLocal();
 	return transform;
 }
 
@@ -170,34 +302,194 @@ glm::mat4 ENG_API Eng::Node::getTransform() const
 void ENG_API Eng::Node::setTransform(glm::mat4 transform)
 {
 	Node::transform = transform;
+	trsMode = false;
+	localDirty = false;
+	transformChanged();
+}
+
+/**
+ * @brief Notify that the local transform changed.
+ */
+void Eng::Node::transformChanged() {
+	if (store != nullptr) {
+		markBoundsDirty();
+		store->setLocal(storeIndex, getTransform());
+	}
+	else
+		setDirty();
+}
+
+/**
+ * @brief Mark the node and its whole subtree as dirty.
+ *
+ * A dirty node always has a dirty subtree, so the propagation stops as soon
+ * as an already dirty node is reached.
+ */
+void ENG_API Eng::Node::setDirty() {
+	markBoundsDirty();
+	if (store != nullptr) {
+		store->setDirty(storeIndex);
+		return;
+	}
+	if (isDirty)
+		return;
+
 	isDirty = true;
+	for (Node* child : children)
+		child->setDirty();
+}
+
+/**
+ * @brief Update the world matrices of the node and of its subtree.
+ *
+ * Top-down pass: every dirty node computes its world matrix once,
+ * starting from the cached world matrix of its parent.
+ */
+void ENG_API Eng::Node::updateWorldTransforms() {
+	updateWorldMatrix();
+
+	for (Node* child : children)
+		child->updateWorldTransforms();
+}
+
+/**
+ * @brief Update the world matrix and the world bounds of the node only.
+ *
+ * Does nothing if the node is not dirty. The parent must be up to date.
+ */
+void ENG_API Eng::Node::updateWorldMatrix() {
+	if (!isDirty)
+		return;
+
+	composeLocal();
+	if (parent != nullptr)
+		finalMatrix = parent->finalMatrix * transform;
+	else
+		finalMatrix = transform;
+	updateWorldBounds(finalMatrix);
+	isDirty = false;
+}
+
+/**
+ * @brief Update the world-space bounds from a world matrix.
+ *
+ * The local bounding sphere center is transformed, the radius is scaled by the largest axis scale.
+ * The local bounding box is transformed into a world-space AABB.
+ * The subtree bounds are refit by the next refitBounds(), the pick grid is notified.
+ *
+ * @param world The node world matrix.
+ */
+void ENG_API Eng::Node::updateWorldBounds(const glm::mat4& world) {
+	const float scaleX = glm::dot(glm::vec3(world[0]), glm::vec3(world[0]));
+	const float scaleY = glm::dot(glm::vec3(world[1]), glm::vec3(world[1]));
+	const float scaleZ = glm::dot(glm::vec3(world[2]), glm::vec3(world[2]));
+
+	worldCenter = glm::vec3(world * glm::vec4(getBoundingSphereCenter(), 1.0f));
+	worldRadius = getBoundingSphereRadius() * sqrtf(std::max(scaleX, std::max(scaleY, scaleZ)));
+
+	glm::vec3 boxMin, boxMax;
+	if (getBoundingBox(boxMin, boxMax)) {
+		// Transformed box: the extent is projected on the world axes
+		const glm::vec3 center = glm::vec3(world * glm::vec4((boxMin + boxMax) * 0.5f, 1.0f));
+		const glm::vec3 half = (boxMax - boxMin) * 0.5f;
+		const glm::vec3 extent = glm::abs(glm::vec3(world[0])) * half.x
+			+ glm::abs(glm::vec3(world[1])) * half.y
+			+ glm::abs(glm::vec3(world[2])) * half.z;
+		worldMin = center - extent;
+		worldMax = center + extent;
+	}
+	else if (worldRadius > 0.0f) {
+		worldMin = worldCenter - glm::vec3(worldRadius);
+		worldMax = worldCenter + glm::vec3(worldRadius);
+	}
+	else {
+		// No geometry: empty box
+		worldMin = glm::vec3(FLT_MAX);
+		worldMax = glm::vec3(-FLT_MAX);
+	}
+	boundsDirty = true;
+	if (pickGrid != nullptr)
+		pickGrid->markMoved(this);
+}
+
+/**
+ * @brief Refit the subtree bounds of the node and of its subtree.
+ *
+ * Bottom-up pass: only the branches containing a node whose world bounds changed are visited.
+ * Must run after the world update.
+ */
+void ENG_API Eng::Node::refitBounds() {
+	if (!boundsDirty)
+		return;
+
+	subtreeMin = worldMin;
+	subtreeMax = worldMax;
+	for (Node* child : children) {
+		child->refitBounds();
+		subtreeMin = glm::min(subtreeMin, child->subtreeMin);
+		subtreeMax = glm::max(subtreeMax, child->subtreeMax);
+	}
+	boundsDirty = false;
+}
+
+/**
+ * @brief Flag the bounds of the node and of its ancestors as out of date.
+ *
+ * The walk stops at the first flagged ancestor: its own ancestors are already flagged.
+ */
+void Eng::Node::markBoundsDirty() {
+	boundsDirty = true;
+	for (Node* node = parent; node != nullptr && !node->boundsDirty; node = node->parent)
+		node->boundsDirty = true;
 }
 
 /**
  * @brief Get the node final matrix.
  *
+ * Returns the cached world matrix. If the node is still dirty the matrix
+ * is recomputed from the cached matrix of the parent.
+ *
  * @return The node final matrix.
  */
-glm::mat4 ENG_API Eng::Node::getFinalMatrix() {
+const glm::mat4 ENG_API& Eng::Node::getFinalMatrix() {
+	if (store != nullptr)
+		return store->getWorld(storeIndex);
+
 	if (isDirty) {
-		Node* par = parent;
-		std::vector<Node*> parents;
-		while (par != nullptr) {
-			parents.push_back(par);
-			par = par->getParent();
-		}
-
-		glm::mat4 m = glm::mat4(1.0f);
-		for (int i = parents.size() - 1; i >= 0; i--) {
-			par = parents.at(i);
-			m *= par->getTransform();
-		}
-		finalMatrix = m * transform;
-		isDirty = false;
+		if (parent != nullptr)
+			parent->getFinalMatrix();
+		updateWorldMatrix();
 	}
 	return finalMatrix;
 }
 
+/**
+ * @brief Attach the node to a flat transform store.
+ *
+ * While attached, the world matrix lives in the store.
+ *
+ * @param store The transform store.
+ * @param index The node index in the store.
+ */
+void ENG_API Eng::Node::attachToStore(TransformStore* newStore, unsigned int index) {
+	store = newStore;
+	storeIndex = index;
+}
+
+/**
+ * @brief Detach the node from its transform store.
+ *
+ * The last world matrix computed by the store is kept as the cached one.
+ */
+void ENG_API Eng::Node::detachFromStore() {
+	if (store == nullptr)
+		return;
+
+	finalMatrix = store->getWorld(storeIndex);
+	isDirty = false;
+	store = nullptr;
+}
+
 /**
  * @brief Get the node world position.
  *
@@ -214,6 +506,7 @@ glm::vec3 ENG_API Eng::Node::getWorldPosition() {
  */
 void ENG_API Eng::Node::setWorldPosition(glm::vec3 position) {
 	transform[3] = glm::vec4(position, 1.0f);
+	transformChanged();
 }
 
 /**
@@ -222,8 +515,18 @@ void ENG_API Eng::Node::setWorldPosition(glm::vec3 position) {
  *
  * @return The number of children.
  */
-unsigned int ENG_API Eng::Node::getNumberOfChildren() {
-	return getChildren().size();
+unsigned int ENG_API Eng::Node::getNumberOfChildren() const {
+	return (unsigned int)children.size();
+}
+
+/**
+ * @brief Get the per-thread scratch queue of the breadth-first traversal.
+ *
+ * @return The queue.
+ */
+std::vector<Eng::Node*>& Eng::Node::traversalQueue() {
+	static thread_local std::vector<Node*> queue;
+	return queue;
 }
 
 /**
@@ -20,6 +20,20 @@
 #ifndef NODE_H
 #define NODE_H
 
+/////////////
+// FORWARD DECLARATION //
+/////////////
+
+/**
+* @brief TransformStore class forward declaration
+*/
+class TransformStore;
+
+/**
+* @brief PickGrid class forward declaration
+*/
+class PickGrid;
+
 /**
 * @brief Node class
 *
@@ -35,8 +49,9 @@ public:
 	 * Initializes the Node.
 	 *
 	 * @param name The node name
+	 * @param type The object type tag, set by the derived classes
 	 */
-   Node(const std::string name);
+   Node(const std::string name, ObjectType type = ObjectType::NODE);
 
 	/**
 	 * @brief Destructor
@@ -59,14 +74,177 @@ public:
 	 */
 	virtual void setTransform(glm::mat4 transform);
 
-	glm::mat4 updateFinalMatrix();
+	/**
+	 * @brief Mark the node and its whole subtree as dirty.
+	 *
+	 * The world matrix of every marked node is recomputed by the next
+	 * updateWorldTransforms() pass (or lazily by getFinalMatrix()).
+	 */
+	void setDirty();
+
+	/**
+	 * @brief Update the world matrices of the node and of its subtree.
+	 *
+	 * Top-down pass: every dirty node computes its world matrix once,
+	 * starting from the cached world matrix of its parent.
+	 */
+	void updateWorldTransforms();
+
+	/**
+	 * @brief Update the world matrix and the world bounds of the node only.
+	 *
+	 * Does nothing if the node is not dirty. The parent must be up to date.
+	 */
+	void updateWorldMatrix();
+
+	/**
+	 * @brief Update the world-space bounds from a world matrix.
+	 *
+	 * The local bounding sphere center is transformed, the radius is scaled by the largest axis scale.
+	 * The local bounding box is transformed into a world-space AABB.
+	 * The subtree bounds are refit by the next refitBounds().
+	 *
+	 * @param world The node world matrix.
+	 */
+	void updateWorldBounds(const glm::mat4& world);
+
+	/**
+	 * @brief Get the minimum corner of the world-space AABB of the node.
+	 *
+	 * @return The minimum corner (greater than the maximum one if the node has no bounds).
+	 */
+	const glm::vec3& getWorldMin() const { return worldMin; }
+
+	/**
+	 * @brief Get the maximum corner of the world-space AABB of the node.
+	 *
+	 * @return The maximum corner.
+	 */
+	const glm::vec3& getWorldMax() const { return worldMax; }
+
+	/**
+	 * @brief Refit the subtree bounds of the node and of its subtree.
+	 *
+	 * Bottom-up pass: only the branches containing a node whose world bounds changed are visited.
+	 * Must run after the world update.
+	 */
+	void refitBounds();
+
+	/**
+	 * @brief Get the minimum corner of the world-space AABB of the subtree, the node included.
+	 *
+	 * @return The minimum corner (greater than the maximum one if the subtree has no bounds).
+	 */
+	const glm::vec3& getSubtreeMin() const { return subtreeMin; }
+
+	/**
+	 * @brief Get the maximum corner of the world-space AABB of the subtree, the node included.
+	 *
+	 * @return The maximum corner.
+	 */
+	const glm::vec3& getSubtreeMax() const { return subtreeMax; }
+
+	/**
+	 * @brief Check if the subtree bounds are waiting for a refit.
+	 *
+	 * On a root, true means that a node of the scene moved since the last refitBounds().
+	 *
+	 * @return True if the subtree bounds are out of date.
+	 */
+	bool hasDirtyBounds() const { return boundsDirty; }
+
+	/**
+	 * @brief Get the frustum plane that rejected the subtree last time.
+	 *
+	 * Culling state kept from frame to frame: the plane is tested first.
+	 *
+	 * @return The plane index.
+	 */
+	unsigned char getCullPlane() const { return cullPlane; }
+
+	/**
+	 * @brief Set the frustum plane that rejected the subtree.
+	 *
+	 * @param plane The plane index.
+	 */
+	void setCullPlane(unsigned char plane) { cullPlane = plane; }
+
+	/**
+	 * @brief Set the detail culling thresholds of the node.
+	 *
+	 * The node is not drawn when, in every view, its bounding sphere covers less than minScreenSize
+	 * of the view height or lies farther than maxDrawDistance. Negative values use the defaults of
+	 * the list, 0 disables the test.
+	 *
+	 * @param minScreenSize The minimum projected diameter, as a fraction of the view height.
+	 * @param maxDrawDistance The maximum view depth of the nearest point of the bounding sphere.
+	 */
+	void setDetailThresholds(float minScreenSize, float maxDrawDistance) { this->minScreenSize = minScreenSize; this->maxDrawDistance = maxDrawDistance; }
+
+	/**
+	 * @brief Get the minimum projected size of the node.
+	 *
+	 * @return The fraction of the view height, negative for the default of the list.
+	 */
+	float getMinScreenSize() const { return minScreenSize; }
+
+	/**
+	 * @brief Get the maximum draw distance of the node.
+	 *
+	 * @return The distance, negative for the default of the list.
+	 */
+	float getMaxDrawDistance() const { return maxDrawDistance; }
+
+	/**
+	 * @brief Get the center of the world-space bounding sphere.
+	 *
+	 * @return The center computed by the last update.
+	 */
+	const glm::vec3& getWorldCenter() const { return worldCenter; }
+
+	/**
+	 * @brief Get the radius of the world-space bounding sphere.
+	 *
+	 * @return The radius computed by the last update.
+	 */
+	float getWorldRadius() const { return worldRadius; }
 
 	/**
 	 * @brief Get the node final matrix.
 	 *
+	 * Returns the cached world matrix. If the node is still dirty the matrix
+	 * is recomputed from the cached matrix of the parent.
+	 *
 	 * @return The node final matrix.
 	 */
-	glm::mat4 getFinalMatrix();
+	const glm::mat4& getFinalMatrix();
+
+	/**
+	 * @brief Attach the node to a flat transform store.
+	 *
+	 * While attached, the world matrix lives in the store.
+	 *
+	 * @param store The transform store.
+	 * @param index The node index in the store.
+	 */
+	void attachToStore(TransformStore* store, unsigned int index);
+
+	/**
+	 * @brief Detach the node from its transform store.
+	 *
+	 * The last world matrix computed by the store is kept as the cached one.
+	 */
+	void detachFromStore();
+
+	/**
+	 * @brief Set the pick grid indexing the node.
+	 *
+	 * The grid is notified every time the world bounds of the node change, so it only
+	 * moves the nodes that moved.
+	 *
+	 * @param grid The pick grid, nullptr when the node leaves it.
+	 */
+	void setPickGrid(PickGrid* grid) { pickGrid = grid; }
 
 	/**
 	 * @brief Get the node child at an index.
@@ -115,7 +293,16 @@ public:
 	 *
 	 * @return The list of children.
 	 */
-	std::vector<Node*> getChildren();
+	const std::vector<Node*>& getChildren() const;
+
+	/**
+	 * @brief Get a non-owning view of the children of the node.
+	 *
+	 * The view is invalidated when a child is added or removed.
+	 *
+	 * @return The children.
+	 */
+	std::span<Node* const> getChildSpan() const { return children; }
 
 	/**
 	 * @brief Set the list of children of the node.
@@ -130,7 +317,71 @@ public:
 	 *
 	 * @return The number of children.
 	 */
-	unsigned int getNumberOfChildren();
+	unsigned int getNumberOfChildren() const;
+
+	/**
+	 * @brief Visitor return value, controls the traversal.
+	 */
+	enum class VisitResult {
+		CONTINUE,     ///< Visit the children of the node
+		SKIP_SUBTREE, ///< Do not visit the children of the node
+		STOP          ///< End the traversal
+	};
+
+	/**
+	 * @brief Depth-first (pre-order) traversal of the subtree, the node included.
+	 *
+	 * Recursive, no heap allocation.
+	 *
+	 * @param visitor Callable taking a Node* and returning a VisitResult.
+	 *
+	 * @return False if the traversal was stopped by the visitor.
+	 */
+	template <typename Visitor>
+	bool visitDepthFirst(Visitor&& visitor) {
+		VisitResult result = visitor(this);
+		if (result == VisitResult::STOP)
+			return false;
+		if (result == VisitResult::SKIP_SUBTREE)
+			return true;
+
+		for (Node* child : children)
+			if (!child->visitDepthFirst(visitor))
+				return false;
+		return true;
+	}
+
+	/**
+	 * @brief Breadth-first traversal of the subtree, the node included.
+	 *
+	 * The queue is a per-thread scratch buffer reused across calls (nested traversals are allowed),
+	 * so no heap allocation happens once it has grown to the size of the scene.
+	 *
+	 * @param visitor Callable taking a Node* and returning a VisitResult.
+	 *
+	 * @return False if the traversal was stopped by the visitor.
+	 */
+	template <typename Visitor>
+	bool visitBreadthFirst(Visitor&& visitor) {
+		std::vector<Node*>& queue = traversalQueue();
+		const size_t base = queue.size();
+		queue.push_back(this);
+
+		bool completed = true;
+		for (size_t i = base; i < queue.size(); i++) {
+			Node* node = queue[i];
+			VisitResult result = visitor(node);
+			if (result == VisitResult::STOP) {
+				completed = false;
+				break;
+			}
+			if (result == VisitResult::CONTINUE)
+				queue.insert(queue.end(), node->children.begin(), node->children.end());
+		}
+
+		queue.resize(base);
+		return completed;
+	}
 
 	/**
 	 * @brief Get the parent of the node.
@@ -161,6 +412,7 @@ public:
 	/**
 	 * @brief Set the node scale.
 	 *
+	 * Uniform version of setLocalScale().
 	 *
 	 * @param The scale.
 	 */
@@ -170,22 +422,151 @@ public:
 	 * @brief Get the node scale.
 	 *
 	 *
-	 * @return The scale.
+	 * @return The scale along the local x axis.
 	 */
 	float getScale() const;
 
+	/**
+	 * @brief Set the local position.
+	 *
+	 * Only the translation of the local matrix changes: nothing is decomposed or recomposed.
+	 *
+	 * @param position The position in the parent space.
+	 */
+	void setLocalPosition(const glm::vec3& position);
+
+	/**
+	 * @brief Set the local rotation.
+	 *
+	 * Switches the node to TRS mode (the current matrix is decomposed once).
+	 * The local matrix is recomposed lazily.
+	 *
+	 * @param rotation The rotation.
+	 */
+	void setLocalRotation(const glm::quat& rotation);
+
+	/**
+	 * @brief Set the local scale.
+	 *
+	 * Switches the node to TRS mode (the current matrix is decomposed once).
+	 * The local matrix is recomposed lazily.
+	 *
+	 * @param scale The scale along the local axes.
+	 */
+	void setLocalScale(const glm::vec3& scale);
+
+	/**
+	 * @brief Get the local position.
+	 *
+	 * @return The position in the parent space.
+	 */
+	glm::vec3 getLocalPosition() const;
+
+	/**
+	 * @brief Get the local rotation.
+	 *
+	 * Outside TRS mode the local matrix is decomposed into a temporary: the mode does not change.
+	 *
+	 * @return The rotation.
+	 */
+	glm::quat getLocalRotation() const;
+
+	/**
+	 * @brief Get the local scale.
+	 *
+	 * Outside TRS mode the local matrix is decomposed into a temporary: the mode does not change.
+	 *
+	 * @return The scale along the local axes.
+	 */
+	glm::vec3 getLocalScale() const;
+
+	/**
+	 * @brief Get the radius of the local bounding sphere.
+	 *
+	 * @return The radius, 0 if the node has no geometry.
+	 */
 	virtual float getBoundingSphereRadius() const { return 0.0f; }
 
+	/**
+	 * @brief Get the center of the local bounding sphere.
+	 *
+	 * @return The center in the node space.
+	 */
+	virtual glm::vec3 getBoundingSphereCenter() const { return glm::vec3(0.0f); }
+
+	/**
+	 * @brief Get the local bounding box.
+	 *
+	 * @param min The minimum corner in the node space.
+	 * @param max The maximum corner in the node space.
+	 *
+	 * @return False if the node has no bounding box.
+	 */
+	virtual bool getBoundingBox(glm::vec3& min, glm::vec3& max) const { return false; }
+
 	bool isGrabbablee() const { return isGrabbable; }
 
 
+// Protected methods
+protected:
+	/**
+	 * @brief Notify that the local transform changed.
+	 */
+	virtual void transformChanged();
+
 // Private methods and fields
 private:
-	glm::mat4 finalMatrix = glm::mat4(1.0f);
-	glm::mat4 transform = glm::mat4(1.0f); /**< The node transform */
+	/**
+	 * @brief Flag the bounds of the node and of its ancestors as out of date.
+	 */
+	void markBoundsDirty();
+
+	/**
+	 * @brief Get the per-thread scratch queue of the breadth-first traversal.
+	 *
+	 * @return The queue.
+	 */
+	static std::vector<Node*>& traversalQueue();
+
+	/**
+	 * @brief Switch to TRS mode, decomposing the current local matrix.
+	 */
+	void enableTRS();
+
+	/**
+	 * @brief Decompose the local matrix into rotation and scale.
+	 *
+	 * @param rotation The rotation.
+	 * @param scale The scale along the local axes.
+	 */
+	void decompose(glm::quat& rotation, glm::vec3& scale) const;
+
+	/**
+	 * @brief Recompose the local matrix from the TRS components if they changed.
+	 */
+	void composeLocal() const;
+
+	TransformStore* store = nullptr; /**< The flat transform store, if any */
+	unsigned int storeIndex = 0; /**< The node index in the store */
+	PickGrid* pickGrid = nullptr; /**< The pick grid indexing the node, if any */
+	glm::mat4 finalMatrix = glm::mat4(1.0f); /**< The cached world matrix */
+	glm::vec3 worldCenter = glm::vec3(0.0f); /**< The cached world bounding sphere center */
+	float worldRadius = 0.0f; /**< The cached world bounding sphere radius */
+	glm::vec3 worldMin = glm::vec3(FLT_MAX); /**< The cached world AABB minimum corner */
+	glm::vec3 worldMax = glm::vec3(-FLT_MAX); /**< The cached world AABB maximum corner */
+	glm::vec3 subtreeMin = glm::vec3(FLT_MAX); /**< The world AABB of the subtree, minimum corner */
+	glm::vec3 subtreeMax = glm::vec3(-FLT_MAX); /**< The world AABB of the subtree, maximum corner */
+	bool boundsDirty = true; /**< True when the subtree AABB must be refit */
+	unsigned char cullPlane = 0; /**< The frustum plane that rejected the subtree last time */
+	float minScreenSize = -1.0f; /**< The minimum projected size, negative for the list default */
+	float maxDrawDistance = -1.0f; /**< The maximum draw distance, negative for the list default */
+	mutable glm::mat4 transform = glm::mat4(1.0f); /**< The node transform (composed from TRS in TRS mode) */
+	glm::quat localRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f); /**< TRS mode rotation */
+	glm::vec3 localScale = glm::vec3(1.0f); /**< TRS mode scale */
+	bool trsMode = false; /**< True when rotation and scale are the source of the local matrix */
+	mutable bool localDirty = false; /**< True when the local matrix must be recomposed */
 	std::vector<Node*> children; /**< The list of children */
 	Node* parent; /**< The node parent. */                          
-	float scale; /**< The node scale. */   
 	bool isDirty; /**< The node dirty flag. */
 	bool isGrabbable; /**< The node grabbable flag. */
 };
@@ -0,0 +1,135 @@
+/**
+* @file nodeRegistry.cpp
+* @brief Implementation of the NodeRegistry class
+*
+* This file contains the implementation of the NodeRegistry class methods.
+*
+* @see NodeRegistry
+* @see nodeRegistry.h
+*
+* @date 2025
+*
+* @details Freed slots are recycled; the generation counter tells a recycled slot from the one a handle
+* was created for.
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+#include "engine.h"
+
+/**
+* @brief Register a node
+*
+* If several nodes share a name, the name resolves to the first one registered.
+*
+* @param node The node to register.
+* @return The handle of the node.
+*/
+Eng::NodeHandle ENG_API Eng::NodeRegistry::add(Node* node) {
+   auto existing = idToSlot.find(node->getId());
+   if (existing != idToSlot.end())
+      return handleOf(existing->second);
+
+   unsigned int index;
+   if (!freeSlots.empty()) {
+      index = freeSlots.back();
+      freeSlots.pop_back();
+   }
+   else {
+      index = (unsigned int)slots.size();
+      slots.push_back(Slot());
+   }
+
+   slots[index].node = node;
+   idToSlot[node->getId()] = index;
+   nameToSlots[node->getName()].push_back(index);
+   return handleOf(index);
+}
+
+/**
+* @brief Unregister a node
+*
+* The handles of the node become stale. Its name then resolves to the next node registered with it, if any.
+*
+* @param node The node to unregister.
+* @return True if the node was registered.
+*/
+bool ENG_API Eng::NodeRegistry::remove(Node* node) {
+   auto it = idToSlot.find(node->getId());
+   if (it == idToSlot.end())
+      return false;
+
+   const unsigned int index = it->second;
+   idToSlot.erase(it);
+
+   // Only this node's entry goes, the other nodes with the same name stay reachable:
+   auto name = nameToSlots.find(node->getName());
+   if (name != nameToSlots.end()) {
+      std::vector<unsigned int>& indices = name->second;
+      indices.erase(std::remove(indices.begin(), indices.end(), index), indices.end());
+      if (indices.empty())
+         nameToSlots.erase(name);
+   }
+
+   slots[index].node = nullptr;
+   slots[index].generation++;
+   freeSlots.push_back(index);
+   return true;
+}
+
+/**
+* @brief Unregister all the nodes
+*
+* All the handles become stale.
+*/
+void ENG_API Eng::NodeRegistry::clear() {
+   freeSlots.clear();
+   for (unsigned int i = 0; i < slots.size(); i++) {
+      if (slots[i].node != nullptr) {
+         slots[i].node = nullptr;
+         slots[i].generation++;
+      }
+      freeSlots.push_back(i);
+   }
+   idToSlot.clear();
+   nameToSlots.clear();
+}
+
+/**
+* @brief Resolve a handle
+*
+* @param handle The handle.
+* @return The node, nullptr if the handle is null or stale.
+*/
+Eng::Node ENG_API* Eng::NodeRegistry::get(NodeHandle handle) const {
+   if (handle.index >= slots.size())
+      return nullptr;
+
+   const Slot& slot = slots[handle.index];
+   return slot.generation == handle.generation ? slot.node : nullptr;
+}
+
+/**
+* @brief Get the handle of a node by ID
+*
+* @param id The object ID.
+* @return The handle, null if no node has the ID.
+*/
+Eng::NodeHandle ENG_API Eng::NodeRegistry::findById(unsigned int id) const {
+   auto it = idToSlot.find(id);
+   return it != idToSlot.end() ? handleOf(it->second) : NodeHandle();
+}
+
+/**
+* @brief Get the handle of a node by name
+*
+* @param name The node name.
+* @return The handle, null if no node has the name.
+*/
+Eng::NodeHandle ENG_API Eng::NodeRegistry::findByName(const std::string& name) const {
+   auto it = nameToSlots.find(name);
+   return it != nameToSlots.end() ? handleOf(it->second.front()) : NodeHandle();
+}
@@ -0,0 +1,145 @@
+/**
+* @file nodeRegistry.h
+* @brief NodeRegistry class header file
+*
+* This file contains the definition of the NodeHandle structure and of the NodeRegistry class, the O(1) lookup
+* table of the nodes of a scene.
+*
+* @date 2025
+*
+* @details A handle is a slot index plus a generation counter: when a node is removed its slot generation is
+* incremented, so the handles still pointing to the slot are detected as stale instead of resolving to
+* whatever node reuses the slot.
+* @see Eng::Node, Eng::List
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+
+#ifndef NODE_REGISTRY_H
+#define NODE_REGISTRY_H
+
+#include "engine.h"
+
+/**
+* @brief NodeHandle structure
+*
+* Weak reference to a registered node.
+*/
+struct NodeHandle {
+   static constexpr unsigned int INVALID_INDEX = 0xFFFFFFFF; /**< Index of the null handle */
+
+   unsigned int index = INVALID_INDEX; /**< The slot index */
+   unsigned int generation = 0; /**< The slot generation at registration time */
+
+   /**
+   * @brief Check if the handle was ever assigned
+   *
+   * A non null handle may still be stale: resolve it through the registry.
+   *
+   * @return True if the handle is not the null handle.
+   */
+   bool isNull() const { return index == INVALID_INDEX; }
+
+   bool operator==(const NodeHandle& other) const { return index == other.index && generation == other.generation; }
+};
+
+/**
+* @brief NodeRegistry class
+*
+* Generational slots plus hash maps from object ID and from name to slot.
+*/
+class ENG_API NodeRegistry {
+public:
+   /**
+   * @brief Constructor
+   *
+   * Initializes an empty registry.
+   */
+   NodeRegistry() {};
+
+   /**
+   * @brief Register a node
+   *
+   * If several nodes share a name, the name resolves to the first one registered.
+   *
+   * @param node The node to register.
+   * @return The handle of the node.
+   */
+   NodeHandle add(Eng::Node* node);
+
+   /**
+   * @brief Unregister a node
+   *
+   * The handles of the node become stale. Its name then resolves to the next node registered with it, if any.
+   *
+   * @param node The node to unregister.
+   * @return True if the node was registered.
+   */
+   bool remove(Eng::Node* node);
+
+   /**
+   * @brief Unregister all the nodes
+   *
+   * All the handles become stale.
+   */
+   void clear();
+
+   /**
+   * @brief Resolve a handle
+   *
+   * @param handle The handle.
+   * @return The node, nullptr if the handle is null or stale.
+   */
+   Eng::Node* get(NodeHandle handle) const;
+
+   /**
+   * @brief Get the handle of a node by ID
+   *
+   * @param id The object ID.
+   * @return The handle, null if no node has the ID.
+   */
+   NodeHandle findById(unsigned int id) const;
+
+   /**
+   * @brief Get the handle of a node by name
+   *
+   * @param name The node name.
+   * @return The handle, null if no node has the name.
+   */
+   NodeHandle findByName(const std::string& name) const;
+
+   /**
+   * @brief Get the number of registered nodes
+   *
+   * @return The number of nodes.
+   */
+   unsigned int size() const { return (unsigned int)idToSlot.size(); }
+
+private:
+   /**
+   * @brief Registry slot
+   */
+   struct Slot {
+      Eng::Node* node = nullptr; /**< The node, nullptr if the slot is free */
+      unsigned int generation = 0; /**< Incremented every time the slot is freed */
+   };
+
+   /**
+   * @brief Get the current handle of a slot
+   *
+   * @param index The slot index.
+   * @return The handle.
+   */
+   NodeHandle handleOf(unsigned int index) const { return NodeHandle{ index, slots[index].generation }; }
+
+   std::vector<Slot> slots; /**< The slots */
+   std::vector<unsigned int> freeSlots; /**< The free slot indices */
+   std::unordered_map<unsigned int, unsigned int> idToSlot; /**< Object ID to slot index */
+   std::unordered_map<std::string, std::vector<unsigned int>> nameToSlots; /**< Name to slot indices, in registration order */
+};
+
+#endif // NODE_REGISTRY_H
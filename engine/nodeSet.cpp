@@ -0,0 +1,80 @@
+/**
+* @file nodeSet.cpp
+* @brief Implementation of the NodeSet class
+*
+* This file contains the implementation of the NodeSet class methods.
+*
+* @see NodeSet
+* @see nodeSet.h
+*
+* @date 2025
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+#include "engine.h"
+
+/**
+* @brief Add a node
+*
+* @param node The node to add.
+* @return False if the node was already in the set.
+*/
+bool ENG_API Eng::NodeSet::add(Node* node) {
+   if (!indices.emplace(node, (unsigned int)nodes.size()).second)
+      return false;
+
+   nodes.push_back(node);
+   return true;
+}
+
+/**
+* @brief Remove a node
+*
+* The last node takes the place of the removed one.
+*
+* @param node The node to remove.
+* @return False if the node was not in the set.
+*/
+bool ENG_API Eng::NodeSet::remove(Node* node) {
+   auto it = indices.find(node);
+   if (it == indices.end())
+      return false;
+
+   const unsigned int index = it->second;
+   indices.erase(it);
+
+   Node* last = nodes.back();
+   nodes.pop_back();
+   if (last != node) {
+      nodes[index] = last;
+      indices[last] = index;
+   }
+   return true;
+}
+
+/**
+* @brief Remove the last node
+*
+* @return The removed node, nullptr if the set is empty.
+*/
+Eng::Node ENG_API* Eng::NodeSet::pop() {
+   if (nodes.empty())
+      return nullptr;
+
+   Node* last = nodes.back();
+   nodes.pop_back();
+   indices.erase(last);
+   return last;
+}
+
+/**
+* @brief Remove all the nodes
+*/
+void ENG_API Eng::NodeSet::clear() {
+   nodes.clear();
+   indices.clear();
+}
@@ -0,0 +1,116 @@
+/**
+* @file nodeSet.h
+* @brief NodeSet class header file
+*
+* This file contains the definition of the NodeSet class, a dense unordered collection of nodes.
+*
+* @date 2025
+*
+* @details The nodes are kept in a contiguous vector; an index map allows constant time removal by
+* swapping the removed node with the last one. The order of the nodes is therefore not preserved.
+* @see Eng::List
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+
+#ifndef NODE_SET_H
+#define NODE_SET_H
+
+#include "engine.h"
+
+/**
+* @brief NodeSet class
+*
+* Vector-backed node collection with swap-and-pop removal.
+*/
+class ENG_API NodeSet {
+public:
+   /**
+   * @brief Constructor
+   *
+   * Initializes an empty set.
+   */
+   NodeSet() {};
+
+   /**
+   * @brief Add a node
+   *
+   * @param node The node to add.
+   * @return False if the node was already in the set.
+   */
+   bool add(Eng::Node* node);
+
+   /**
+   * @brief Remove a node
+   *
+   * The last node takes the place of the removed one.
+   *
+   * @param node The node to remove.
+   * @return False if the node was not in the set.
+   */
+   bool remove(Eng::Node* node);
+
+   /**
+   * @brief Remove the last node
+   *
+   * @return The removed node, nullptr if the set is empty.
+   */
+   Eng::Node* pop();
+
+   /**
+   * @brief Check if a node is in the set
+   *
+   * @param node The node.
+   * @return True if the node is in the set.
+   */
+   bool contains(Eng::Node* node) const { return indices.find(node) != indices.end(); }
+
+   /**
+   * @brief Remove all the nodes
+   */
+   void clear();
+
+   /**
+   * @brief Get a non-owning view of the nodes
+   *
+   * The view is invalidated by add and remove.
+   *
+   * @return The nodes.
+   */
+   std::span<Eng::Node* const> view() const { return nodes; }
+
+   /**
+   * @brief Get the node at an index
+   *
+   * @param index The index.
+   * @return The node.
+   */
+   Eng::Node* at(unsigned int index) const { return nodes[index]; }
+
+   /**
+   * @brief Get the number of nodes
+   *
+   * @return The number of nodes.
+   */
+   unsigned int size() const { return (unsigned int)nodes.size(); }
+
+   /**
+   * @brief Check if the set is empty
+   *
+   * @return True if there are no nodes.
+   */
+   bool empty() const { return nodes.empty(); }
+
+   std::vector<Eng::Node*>::const_iterator begin() const { return nodes.begin(); }
+   std::vector<Eng::Node*>::const_iterator end() const { return nodes.end(); }
+
+private:
+   std::vector<Eng::Node*> nodes; /**< The nodes */
+   std::unordered_map<Eng::Node*, unsigned int> indices; /**< Position of each node in the vector */
+};
+
+#endif // NODE_SET_H
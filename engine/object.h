@@ -19,6 +19,28 @@
 #ifndef OBJECT_H
 #define OBJECT_H
 
+/**
+* @brief Object type tag
+*
+* Fixed at construction, used to dispatch without RTTI. The light types are contiguous.
+*/
+enum class ObjectType : unsigned char {
+	OBJECT = 0,        ///< Generic object
+	NODE,              ///< Plain node
+	MESH,              ///< Mesh
+	CAMERA,            ///< Camera
+	SKYBOX,            ///< Skybox
+	LIGHT,             ///< Light without a subtype
+	LIGHT_DIRECTIONAL, ///< Directional light
+	LIGHT_POINT,       ///< Point (omni) light
+	LIGHT_SPOT,        ///< Spot light
+	MATERIAL,          ///< Material
+	TEXTURE,           ///< Texture
+	SHADER,            ///< Shader
+	LIST,              ///< Render list
+	LAST               ///< Number of types
+};
+
 /**
 * @brief Object class
 *
@@ -76,8 +98,39 @@ public:
 	 */
 	unsigned int getNextId();
 
+	/**
+	 * @brief Get the object type tag.
+	 *
+	 * @return The type fixed at construction.
+	 */
+	ObjectType getObjectType() const { return objectType; }
+
+	/**
+	 * @brief Check if the object is a light of any subtype.
+	 *
+	 * @return True for lights.
+	 */
+	bool isLight() const { return objectType >= ObjectType::LIGHT && objectType <= ObjectType::LIGHT_SPOT; }
+
+	/**
+	 * @brief Destructor
+	 *
+	 * Virtual: the lists delete their nodes through base pointers.
+	 */
+	virtual ~Object() {}
+
+// Protected methods
+protected:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param type The object type tag.
+	 */
+	Object(ObjectType type = ObjectType::OBJECT) : objectType(type) {}
+
 // Private methods and fields
 private:
+	ObjectType objectType; /**< The object type tag */
 	unsigned int id; /**< The object Id. */
 	std::string name; /**< The object name. */
 };
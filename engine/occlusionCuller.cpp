@@ -0,0 +1,316 @@
+/**
+* @file occlusionCuller.cpp
+* @brief Implementation of the OcclusionCuller class
+*
+* This file contains the implementation of the OcclusionCuller class methods.
+*
+* @see OcclusionCuller
+* @see occlusionCuller.h
+*
+* @date 2025
+*
+* @details The rasterizer evaluates the edge functions of 4 adjacent pixels at once with SSE when the
+* compiler targets it, one pixel at a time otherwise. Occluders are rasterized conservatively: a pixel is
+* only written when the triangle covers it entirely, with the farthest depth of the triangle over the pixel.
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+#include "engine.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENG_OCCLUSION_SSE
+#include <emmintrin.h>
+#endif
+
+/**
+* @brief Smallest clip w accepted: points closer to the eye plane are treated as crossing the near plane.
+*/
+static const float minClipW = 1e-5f;
+
+/**
+* @brief Constructor
+*
+* @param width The depth buffer width (rounded up to a multiple of 4).
+* @param height The depth buffer height.
+*/
+ENG_API Eng::OcclusionCuller::OcclusionCuller(unsigned int width, unsigned int height) {
+   setResolution(width, height);
+}
+
+/**
+* @brief Set the depth buffer resolution
+*
+* @param width The depth buffer width (rounded up to a multiple of 4).
+* @param height The depth buffer height.
+*/
+void ENG_API Eng::OcclusionCuller::setResolution(unsigned int newWidth, unsigned int newHeight) {
+   width = std::max(4u, (newWidth + 3) & ~3u);
+   height = std::max(1u, newHeight);
+   depth.assign(width * height, 1.0f);
+}
+
+/**
+* @brief Remove the occluded objects
+*
+* The objects are the output of the frustum stage. The order of the kept objects is preserved.
+*
+* @param objects The visible objects, compacted in place.
+* @param viewProjections The View-Projection matrices of the views.
+* @param count The number of views.
+* @return The number of rejected objects.
+*/
+unsigned int ENG_API Eng::OcclusionCuller::cull(std::vector<Node*>& objects, const glm::mat4* viewProjections, unsigned int count) {
+   rejectedCount = 0;
+   if (count == 0)
+      return 0;
+   selectOccluders(objects, viewProjections[0]);
+   if (occluders.empty())
+      return 0;
+
+   // The occluders are visible by construction:
+   keep.assign(objects.size(), 0);
+   for (unsigned int index : occluders)
+      keep[index] = 1;
+
+   // An object is rejected only if it is hidden in every view:
+   for (unsigned int v = 0; v < count; v++) {
+      clear();
+      for (unsigned int index : occluders)
+         rasterizeOccluder(static_cast<Mesh*>(objects[index]), viewProjections[v]);
+
+      for (unsigned int i = 0; i < (unsigned int)objects.size(); i++)
+         if (!keep[i] && isVisible(objects[i], viewProjections[v]))
+            keep[i] = 1;
+   }
+
+   unsigned int kept = 0;
+   for (unsigned int i = 0; i < (unsigned int)objects.size(); i++)
+      if (keep[i])
+         objects[kept++] = objects[i];
+   rejectedCount = (unsigned int)objects.size() - kept;
+   objects.resize(kept);
+   return rejectedCount;
+}
+
+/**
+* @brief Pick the occluders among the visible objects
+*
+* Only static meshes (not grabbable) with a bounding box and triangles qualify; the ones with the
+* largest apparent size are kept.
+*
+* @param objects The visible objects.
+* @param viewProjection The View-Projection matrix of the first view.
+*/
+void Eng::OcclusionCuller::selectOccluders(const std::vector<Node*>& objects, const glm::mat4& viewProjection) {
+   occluders.clear();
+   candidates.clear();
+   if (maxOccluders == 0)
+      return;
+
+   glm::vec3 boxMin, boxMax;
+   for (unsigned int i = 0; i < (unsigned int)objects.size(); i++) {
+      Node* node = objects[i];
+      if (node->getObjectType() != ObjectType::MESH || node->isGrabbablee() || !node->getBoundingBox(boxMin, boxMax))
+         continue;
+      if (static_cast<Mesh*>(node)->getFaces().empty())
+         continue;
+
+      // Clip w is the distance along the view direction:
+      const float distance = (viewProjection * glm::vec4(node->getWorldCenter(), 1.0f)).w;
+      const float size = distance > minClipW ? node->getWorldRadius() / distance : FLT_MAX;
+      if (size >= minOccluderSize)
+         candidates.emplace_back(size, i);
+   }
+
+   // Keep the largest:
+   const size_t count = std::min(candidates.size(), (size_t)maxOccluders);
+   std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(), std::greater<>());
+   for (size_t i = 0; i < count; i++)
+      occluders.push_back(candidates[i].second);
+}
+
+/**
+* @brief Reset the depth buffer to the far plane
+*/
+void Eng::OcclusionCuller::clear() {
+   std::fill(depth.begin(), depth.end(), 1.0f);
+}
+
+/**
+* @brief Rasterize the triangles of an occluder
+*
+* Triangles crossing the near plane are skipped (they could only hide more).
+*
+* @param mesh The occluder.
+* @param viewProjection The View-Projection matrix.
+*/
+void Eng::OcclusionCuller::rasterizeOccluder(Mesh* mesh, const glm::mat4& viewProjection) {
+   const glm::mat4 mvp = viewProjection * mesh->getFinalMatrix();
+
+   // Project the vertices once: (x, y) in pixels, NDC depth, w < 0 marks a vertex behind the near plane
+   const std::vector<glm::vec3>& vertices = mesh->getVertices();
+   clipVertices.resize(vertices.size());
+   for (size_t i = 0; i < vertices.size(); i++) {
+      const glm::vec4 clip = mvp * glm::vec4(vertices[i], 1.0f);
+      if (clip.w <= minClipW) {
+         clipVertices[i] = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);
+         continue;
+      }
+      const float invW = 1.0f / clip.w;
+      clipVertices[i] = glm::vec4((clip.x * invW * 0.5f + 0.5f) * width, (clip.y * invW * 0.5f + 0.5f) * height, clip.z * invW, 1.0f);
+   }
+
+   const std::vector<unsigned int>& faces = mesh->getFaces();
+   for (size_t f = 0; f + 2 < faces.size(); f += 3) {
+      const glm::vec4& a = clipVertices[faces[f]];
+      const glm::vec4& b = clipVertices[faces[f + 1]];
+      const glm::vec4& c = clipVertices[faces[f + 2]];
+      if (a.w < 0.0f || b.w < 0.0f || c.w < 0.0f)
+         continue;
+      rasterizeTriangle(glm::vec3(a), glm::vec3(b), glm::vec3(c));
+   }
+}
+
+/**
+* @brief Rasterize a triangle, keeping the nearest depth
+*
+* Both windings are drawn: occluders are closed meshes and only the nearest depth is kept.
+*
+* @param v0 First vertex, (x, y) in pixels and NDC depth.
+* @param v1 Second vertex.
+* @param v2 Third vertex.
+*/
+void Eng::OcclusionCuller::rasterizeTriangle(const glm::vec3& v0, const glm::vec3& v1In, const glm::vec3& v2In) {
+   float area = (v1In.x - v0.x) * (v2In.y - v0.y) - (v1In.y - v0.y) * (v2In.x - v0.x);
+   if (std::abs(area) < 1e-8f)
+      return;
+
+   // Counter-clockwise order: the edge functions are positive inside
+   const bool flip = area < 0.0f;
+   const glm::vec3& v1 = flip ? v2In : v1In;
+   const glm::vec3& v2 = flip ? v1In : v2In;
+   area = std::abs(area);
+
+   // Pixel bounds, x aligned to 4 for the SIMD loop:
+   const int minX = std::max(0, (int)std::floor(std::min(v0.x, std::min(v1.x, v2.x)))) & ~3;
+   const int maxX = std::min((int)width - 1, (int)std::floor(std::max(v0.x, std::max(v1.x, v2.x))));
+   const int minY = std::max(0, (int)std::floor(std::min(v0.y, std::min(v1.y, v2.y))));
+   const int maxY = std::min((int)height - 1, (int)std::floor(std::max(v0.y, std::max(v1.y, v2.y))));
+   if (minX > maxX || minY > maxY)
+      return;
+
+   // Edge functions e(p) = A * x + B * y + C, one per edge, opposite to v0, v1 and v2:
+   const glm::vec3 edgeA(v1.y - v2.y, v2.y - v0.y, v0.y - v1.y);
+   const glm::vec3 edgeB(v2.x - v1.x, v0.x - v2.x, v1.x - v0.x);
+   const glm::vec3 edgeC(-edgeA.x * v1.x - edgeB.x * v1.y, -edgeA.y * v2.x - edgeB.y * v2.y, -edgeA.z * v0.x - edgeB.z * v0.y);
+
+   // Depth plane z(p) = (e0 * z0 + e1 * z1 + e2 * z2) / area:
+   const glm::vec3 weights = glm::vec3(v0.z, v1.z, v2.z) / area;
+   const float depthX = glm::dot(edgeA, weights);
+   const float depthY = glm::dot(edgeB, weights);
+
+   // Evaluated at the pixel centers, a linear function is off by at most half of |A| + |B| over the pixel.
+   // Edges pulled in by that much only accept the pixels the triangle fully covers, and the depth
+   // pushed back by that much is the farthest depth of the triangle over the pixel:
+   const glm::vec3 coverC = edgeC - 0.5f * (glm::abs(edgeA) + glm::abs(edgeB));
+   const float depthC = glm::dot(edgeC, weights) + 0.5f * (std::abs(depthX) + std::abs(depthY));
+
+#ifdef ENG_OCCLUSION_SSE
+   const __m128 offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+   const __m128 zero = _mm_setzero_ps();
+   for (int y = minY; y <= maxY; y++) {
+      const float py = (float)y + 0.5f;
+      const __m128 row0 = _mm_set1_ps(edgeB.x * py + coverC.x);
+      const __m128 row1 = _mm_set1_ps(edgeB.y * py + coverC.y);
+      const __m128 row2 = _mm_set1_ps(edgeB.z * py + coverC.z);
+      const __m128 rowDepth = _mm_set1_ps(depthY * py + depthC);
+      float* line = depth.data() + y * width;
+
+      for (int x = minX; x <= maxX; x += 4) {
+         const __m128 px = _mm_add_ps(_mm_set1_ps((float)x), offsets);
+         const __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA.x), px), row0);
+         const __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA.y), px), row1);
+         const __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA.z), px), row2);
+         const __m128 inside = _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_and_ps(_mm_cmpge_ps(e1, zero), _mm_cmpge_ps(e2, zero)));
+         if (_mm_movemask_ps(inside) == 0)
+            continue;
+
+         const __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthX), px), rowDepth);
+         const __m128 current = _mm_loadu_ps(line + x);
+         const __m128 nearest = _mm_min_ps(current, z);
+         _mm_storeu_ps(line + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+      }
+   }
+#else
+   for (int y = minY; y <= maxY; y++) {
+      const float py = (float)y + 0.5f;
+      float* line = depth.data() + y * width;
+      for (int x = minX; x <= maxX; x++) {
+         const float px = (float)x + 0.5f;
+         if (edgeA.x * px + edgeB.x * py + coverC.x < 0.0f || edgeA.y * px + edgeB.y * py + coverC.y < 0.0f
+            || edgeA.z * px + edgeB.z * py + coverC.z < 0.0f)
+            continue;
+         line[x] = std::min(line[x], depthX * px + depthY * py + depthC);
+      }
+   }
+#endif
+}
+
+/**
+* @brief Test the world AABB of an object against the depth buffer
+*
+* The nearest depth of the box is compared with the pixels of its screen rectangle.
+* Boxes crossing the near plane, or without bounds, are always visible.
+*
+* @param node The object.
+* @param viewProjection The View-Projection matrix.
+* @return False if every pixel of the screen rectangle is nearer than the box.
+*/
+bool Eng::OcclusionCuller::isVisible(Node* node, const glm::mat4& viewProjection) const {
+   const glm::vec3& boxMin = node->getWorldMin();
+   const glm::vec3& boxMax = node->getWorldMax();
+   if (boxMin.x > boxMax.x)
+      return true;
+
+   glm::vec3 screenMin(FLT_MAX), screenMax(-FLT_MAX);
+   for (int i = 0; i < 8; i++) {
+      const glm::vec3 corner((i & 1) ? boxMax.x : boxMin.x, (i & 2) ? boxMax.y : boxMin.y, (i & 4) ? boxMax.z : boxMin.z);
+      const glm::vec4 clip = viewProjection * glm::vec4(corner, 1.0f);
+      if (clip.w <= minClipW)
+         return true;
+      const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+      screenMin = glm::min(screenMin, ndc);
+      screenMax = glm::max(screenMax, ndc);
+   }
+   if (screenMin.z <= -1.0f)
+      return true;
+
+   const int minX = std::max(0, (int)std::floor((screenMin.x * 0.5f + 0.5f) * width)) & ~3;
+   const int maxX = std::min((int)width - 1, (int)std::floor((screenMax.x * 0.5f + 0.5f) * width));
+   const int minY = std::max(0, (int)std::floor((screenMin.y * 0.5f + 0.5f) * height));
+   const int maxY = std::min((int)height - 1, (int)std::floor((screenMax.y * 0.5f + 0.5f) * height));
+   if (minX > maxX || minY > maxY)
+      return true;
+
+#ifdef ENG_OCCLUSION_SSE
+   const __m128 nearest = _mm_set1_ps(screenMin.z);
+   for (int y = minY; y <= maxY; y++) {
+      const float* line = depth.data() + y * width;
+      for (int x = minX; x <= maxX; x += 4)
+         if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(line + x), nearest)))
+            return true;
+   }
+#else
+   for (int y = minY; y <= maxY; y++) {
+      const float* line = depth.data() + y * width;
+      for (int x = minX; x <= maxX; x++)
+         if (line[x] >= screenMin.z)
+            return true;
+   }
+#endif
+   return false;
+}
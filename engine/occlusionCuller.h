@@ -0,0 +1,159 @@
+/**
+* @file occlusionCuller.h
+* @brief OcclusionCuller class header file
+*
+* This file contains the definition of the OcclusionCuller class, the CPU occlusion stage that removes
+* the objects hidden behind large static meshes before any draw is submitted.
+*
+* @date 2025
+*
+* @details Every frame the largest static meshes in the frustum are rasterized into a low-resolution
+* depth buffer (SSE, 4 pixels at a time, scalar fallback). The screen rectangle of the world AABB of every
+* other visible object is then compared with the buffer: an object is rejected only if it is hidden in
+* every view (both eyes). No GPU query is involved.
+* @see Eng::List, Eng::Mesh
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+
+#ifndef OCCLUSION_CULLER_H
+#define OCCLUSION_CULLER_H
+
+#include "engine.h"
+
+/**
+* @brief OcclusionCuller class
+*
+* Software depth buffer occlusion culling.
+*/
+class ENG_API OcclusionCuller {
+public:
+   /**
+   * @brief Constructor
+   *
+   * @param width The depth buffer width (rounded up to a multiple of 4).
+   * @param height The depth buffer height.
+   */
+   OcclusionCuller(unsigned int width = 128, unsigned int height = 128);
+
+   /**
+   * @brief Set the depth buffer resolution
+   *
+   * @param width The depth buffer width (rounded up to a multiple of 4).
+   * @param height The depth buffer height.
+   */
+   void setResolution(unsigned int width, unsigned int height);
+
+   /**
+   * @brief Set the maximum number of occluders rasterized per view
+   *
+   * The static meshes with the largest apparent size are chosen.
+   *
+   * @param count The number of occluders.
+   */
+   void setMaxOccluders(unsigned int count) { maxOccluders = count; }
+
+   /**
+   * @brief Set the minimum apparent size of an occluder
+   *
+   * The apparent size is the world bounding radius divided by the distance from the eye:
+   * small or distant meshes hide little and are not worth rasterizing.
+   *
+   * @param size The minimum apparent size.
+   */
+   void setMinOccluderSize(float size) { minOccluderSize = size; }
+
+   /**
+   * @brief Remove the occluded objects
+   *
+   * The objects are the output of the frustum stage. The order of the kept objects is preserved.
+   *
+   * @param objects The visible objects, compacted in place.
+   * @param viewProjections The View-Projection matrices of the views.
+   * @param count The number of views.
+   * @return The number of rejected objects.
+   */
+   unsigned int cull(std::vector<Node*>& objects, const glm::mat4* viewProjections, unsigned int count);
+
+   /**
+   * @brief Get the number of objects rejected by the last cull()
+   *
+   * @return The number of rejected objects.
+   */
+   unsigned int getRejectedCount() const { return rejectedCount; }
+
+   /**
+   * @brief Get the number of occluders used by the last cull()
+   *
+   * @return The number of occluders.
+   */
+   unsigned int getOccluderCount() const { return (unsigned int)occluders.size(); }
+
+   /**
+   * @brief Get the depth buffer of the last view
+   *
+   * Row-major, NDC depth (1 is the far plane).
+   *
+   * @return The depth values.
+   */
+   const std::vector<float>& getDepthBuffer() const { return depth; }
+
+private:
+   /**
+   * @brief Pick the occluders among the visible objects
+   *
+   * @param objects The visible objects.
+   * @param viewProjection The View-Projection matrix of the first view.
+   */
+   void selectOccluders(const std::vector<Node*>& objects, const glm::mat4& viewProjection);
+
+   /**
+   * @brief Reset the depth buffer to the far plane
+   */
+   void clear();
+
+   /**
+   * @brief Rasterize the triangles of an occluder
+   *
+   * Triangles crossing the near plane are skipped (they could only hide more).
+   *
+   * @param mesh The occluder.
+   * @param viewProjection The View-Projection matrix.
+   */
+   void rasterizeOccluder(Mesh* mesh, const glm::mat4& viewProjection);
+
+   /**
+   * @brief Rasterize a triangle, keeping the nearest depth
+   *
+   * @param v0 First vertex, (x, y) in pixels and NDC depth.
+   * @param v1 Second vertex.
+   * @param v2 Third vertex.
+   */
+   void rasterizeTriangle(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2);
+
+   /**
+   * @brief Test the world AABB of an object against the depth buffer
+   *
+   * @param node The object.
+   * @param viewProjection The View-Projection matrix.
+   * @return False if every pixel of the screen rectangle is nearer than the box.
+   */
+   bool isVisible(Node* node, const glm::mat4& viewProjection) const;
+
+   unsigned int width; /**< Depth buffer width, multiple of 4 */
+   unsigned int height; /**< Depth buffer height */
+   std::vector<float> depth; /**< The depth buffer */
+   unsigned int maxOccluders = 8; /**< Maximum number of occluders */
+   float minOccluderSize = 0.1f; /**< Minimum apparent size of an occluder */
+   std::vector<unsigned int> occluders; /**< Indices of the occluders in the culled objects */
+   std::vector<std::pair<float, unsigned int>> candidates; /**< Occluder candidates, apparent size and index */
+   std::vector<glm::vec4> clipVertices; /**< Scratch buffer of the projected occluder vertices */
+   std::vector<unsigned char> keep; /**< Per-object result, visible in at least one view */
+   unsigned int rejectedCount = 0; /**< Objects rejected by the last cull */
+};
+
+#endif // OCCLUSION_CULLER_H
@@ -65,10 +65,11 @@ std::string _path; /**< Path of the file */
  * @brief Read the .ovo file.
  *
  * @param filePath The file path to the .ovo.
+ * @param arena The arena that will own the loaded objects, nullptr to allocate them on the heap.
  *
  * @return The root of the scene.
  */
-Eng::Node* Eng::OvoReader::readFile(const char* path) {
+Eng::Node* Eng::OvoReader::readFile(const char* path, SceneArena* sceneArena) {
 	// Open file:
 	FILE* dat = fopen(path, "rb");
 	if (dat == nullptr)
@@ -79,9 +80,18 @@ Eng::Node* Eng::OvoReader::readFile(const char* path) {
 
 	_path = path;
 
+	// Materials belong to the scene being loaded:
+	materials.clear();
+	arena = sceneArena;
+
 	Node* root = recursiveLoad(dat);
 	fclose(dat);
 
+	if (arena != nullptr)
+		std::cout << "Scene arena: " << arena->getObjectCount() << " objects, " << arena->getBytesUsed() / 1024
+			<< " KB of object storage in " << arena->getBlockCount() << " blocks (names and buffers not counted)" << std::endl;
+	arena = nullptr;
+
 	return root;
 }
 
@@ -101,12 +111,13 @@ Eng::Node* Eng::OvoReader::recursiveLoad(FILE* dat)
 	fread(&chunkSize, sizeof(unsigned int), 1, dat);
 
 	// Load whole chunk into memory:
-	char* data = new char[chunkSize];
+	if (chunkBuffer.size() < chunkSize)
+		chunkBuffer.resize(chunkSize);
+	char* data = chunkBuffer.data();
 	if (fread(data, sizeof(char), chunkSize, dat) != chunkSize)
 	{
 		std::cout << "ERROR: unable to read from file" << std::endl;
-		fclose(dat);
-		delete[] data;
+		return nullptr;
 	}
 
 	//First Object
@@ -152,12 +163,15 @@ Eng::Node* Eng::OvoReader::recursiveLoad(FILE* dat)
 		std::string textureName_str = std::string(textureName);
 
 		//Save material on data structure
-		Material* material = new Material(materialName_str, glm::vec3(emission), glm::vec3(albedo * 0.2f), glm::vec3(albedo * 0.6f), glm::vec3(albedo * 0.4f), (1 - sqrt(roughness)) * 128);
+		Material* material = create<Material>(materialName_str, glm::vec3(emission), glm::vec3(albedo * 0.2f), glm::vec3(albedo * 0.6f), glm::vec3(albedo * 0.4f), (1 - sqrt(roughness)) * 128);
 		materials.insert(std::pair<std::string, Material*>(material->getName(), material));
 
-		Texture* texture = new Texture(textureName_str);
+		Texture* texture = create<Texture>(textureName_str);
 		material->setTexture(texture);
 
+		// Colors go to the material uniform buffer once, the meshes share the slot:
+		material->upload();
+
 		if (textureName_str != "[none]") {
 			texture->setTextureId(_path.substr(0, _path.find_last_of(getSeparator())) + getSeparator() + textureName_str);
 		}
@@ -186,7 +200,7 @@ Eng::Node* Eng::OvoReader::recursiveLoad(FILE* dat)
 	{
 	case OvObject::Type::O_NODE:
 	{
-		Node* thisNode = new Node(nodeName_str);
+		Node* thisNode = create<Node>(nodeName_str);
 		thisNode->setTransform(matrix);
 
 		// Go recursive when child nodes are avaialble:
@@ -194,6 +208,8 @@ Eng::Node* Eng::OvoReader::recursiveLoad(FILE* dat)
 			while (thisNode->getNumberOfChildren() < nrOfChildren)
 			{
 				Node* childNode = recursiveLoad(dat);
+				if (childNode == nullptr)
+					break;
 				thisNode->addChild(childNode);
 			}
 
@@ -225,10 +241,10 @@ Eng::Node* Eng::OvoReader::recursiveLoad(FILE* dat)
 		auto it = materials.find(materialName_str);
 		if (it != materials.end()) {
 			Material material = *(it->second);
-			thisMesh = new Mesh(nodeName_str, material);
+			thisMesh = create<Mesh>(nodeName_str, material);
 		}
 		else {
-			thisMesh = new Mesh(nodeName_str, Material());
+			thisMesh = create<Mesh>(nodeName_str, Material());
 		}
 		thisMesh->setTransform(matrix);
 
@@ -243,7 +259,10 @@ Eng::Node* Eng::OvoReader::recursiveLoad(FILE* dat)
 		memcpy(&bBoxMin, data + position, sizeof(glm::vec3));
 		position += sizeof(glm::vec3);
 		// Mesh bounding box maximum corner:
+		glm::vec3 bBoxMax;
+		memcpy(&bBoxMax, data + position, sizeof(glm::vec3));
 		position += sizeof(glm::vec3);
+		thisMesh->setBoundingBox(bBoxMin, bBoxMax);
 		// Optional physics properties:
 		unsigned char hasPhysics;
 		memcpy(&hasPhysics, data + position, sizeof(unsigned char));
@@ -330,11 +349,15 @@ Eng::Node* Eng::OvoReader::recursiveLoad(FILE* dat)
 			std::cout << "\tNr. of vertices: " << vertices << std::endl;
 			
 			LODData lodData;
+			lodData.verticesCoords.reserve(vertices);
+			lodData.normalsCoords.reserve(vertices);
+			lodData.texCoords.reserve(vertices);
 
 			// ...and faces:
 			memcpy(&faces, data + position, sizeof(unsigned int));
 			position += sizeof(unsigned int);
 			std::cout << "\tNr. of faces: " << faces << std::endl;
+			lodData.facesArray.reserve(faces * 3);
 
 			// Otherwise, process the current LOD (as before):
 			// Interleaved and compressed vertex/normal/UV/tangent data:
@@ -382,6 +405,8 @@ Eng::Node* Eng::OvoReader::recursiveLoad(FILE* dat)
 		if (nrOfChildren) {
 			while (thisMesh->getNumberOfChildren() < nrOfChildren) {
 				Node* childNode = recursiveLoad(dat);
+				if (childNode == nullptr)
+					break;
 				thisMesh->addChild(childNode);
 			}
 		}
@@ -461,33 +486,36 @@ Eng::Node* Eng::OvoReader::recursiveLoad(FILE* dat)
 		{
 		case OvLight::Subtype::DIRECTIONAL:
 		{
-			thisLight = new DirectionalLight(nodeName_str, nextLightPointer, glm::vec4(glm::vec3(color.x), 1.0f), glm::vec4(glm::vec3(color.y), 1.0f), glm::vec4(glm::vec3(color.z), 1.0f));
+			thisLight = create<DirectionalLight>(nodeName_str, nextLightPointer, glm::vec4(glm::vec3(color.x), 1.0f), glm::vec4(glm::vec3(color.y), 1.0f), glm::vec4(glm::vec3(color.z), 1.0f));
 		}break;
 		case OvLight::Subtype::OMNI:
 		{
-			thisLight = new PointLight(nodeName_str, nextLightPointer, glm::vec3(color.x), glm::vec3(color.y), glm::vec3(color.z), cutoff);
+			thisLight = create<PointLight>(nodeName_str, nextLightPointer, glm::vec3(color.x), glm::vec3(color.y), glm::vec3(color.z), cutoff);
 		}break;
 		case OvLight::Subtype::SPOT:
 		{
-			thisLight = new SpotLight(nodeName_str, nextLightPointer, glm::vec4(glm::vec3(color.x), 1.0f), glm::vec4(glm::vec3(color.y), 1.0f), glm::vec4(glm::vec3(color.z), 1.0f), cutoff, direction);
+			thisLight = create<SpotLight>(nodeName_str, nextLightPointer, glm::vec4(glm::vec3(color.x), 1.0f), glm::vec4(glm::vec3(color.y), 1.0f), glm::vec4(glm::vec3(color.z), 1.0f), cutoff, direction);
 		}break;
 		default:
-			thisLight = new Light(nodeName_str, nextLightPointer, glm::vec4(glm::vec3(color.x), 1.0f), glm::vec4(glm::vec3(color.y), 1.0f), glm::vec4(glm::vec3(color.z), 1.0f));
+			thisLight = create<Light>(nodeName_str, nextLightPointer, glm::vec4(glm::vec3(color.x), 1.0f), glm::vec4(glm::vec3(color.y), 1.0f), glm::vec4(glm::vec3(color.z), 1.0f));
 		}
 
 		thisLight->setTransform(matrix);
+		thisLight->setInfluenceRadius(radius);
 
 		// Go recursive when child nodes are avaialble:
 		if (nrOfChildren)
 			while (thisLight->getNumberOfChildren() < nrOfChildren)
 			{
 				Node* childNode = recursiveLoad(dat);
+				if (childNode == nullptr)
+					break;
 				thisLight->addChild(childNode);
 			}
 		// Done:
 		return thisLight;
 	}
 	}
-	delete[] data;
+	return nullptr;
 }
 
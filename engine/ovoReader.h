@@ -48,10 +48,11 @@ public:
     * @brief Read the .ovo file.
     *
     * @param filePath The file path to the .ovo.
+    * @param arena The arena that will own the loaded objects, nullptr to allocate them on the heap.
     *
     * @return The root of the scene.
     */
-   Eng::Node* readFile(const char* filePath);
+   Eng::Node* readFile(const char* filePath, Eng::SceneArena* arena = nullptr);
 
 // Private methods and fields
 private:
@@ -64,6 +65,22 @@ private:
     */
    Eng::Node* recursiveLoad(FILE* dat);
 
+   /**
+    * @brief Construct a scene object, in the arena when there is one.
+    *
+    * @param args The constructor arguments.
+    *
+    * @return The new object.
+    */
+   template <typename T, typename... Args>
+   T* create(Args&&... args) {
+      if (arena != nullptr)
+         return arena->create<T>(std::forward<Args>(args)...);
+      return new T(std::forward<Args>(args)...);
+   }
+
+   Eng::SceneArena* arena = nullptr; /**< The arena of the scene being loaded */
+   std::vector<char> chunkBuffer; /**< Chunk data, reused by every chunk (a chunk is fully parsed before its children) */
    std::map<std::string, Eng::Material*> materials; /**< Map of the material name and his referred material. */
    std::vector<glm::vec3> verticesCoords;
    std::vector<glm::vec3> normalsCoords;
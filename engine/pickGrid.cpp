@@ -0,0 +1,273 @@
+/**
+* @file pickGrid.cpp
+* @brief Implementation of the PickGrid class
+*
+* This file contains the implementation of the PickGrid class methods.
+*
+* @see PickGrid
+* @see pickGrid.h
+*
+* @date 2025
+*
+* @details Loose uniform grid: every node is stored in the single cell containing the center of its
+* world bounding sphere, and the queries widen their range by the largest radius.
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+#include "engine.h"
+
+/**
+* @brief Smallest cell edge: keeps the cell coordinates in range for tiny or not yet updated nodes.
+*/
+static const float minCellSize = 1e-3f;
+
+/**
+* @brief Add a node
+*
+* The node is binned with its current world bounds and checked again by the next refresh().
+*
+* @param node The node to add.
+* @return False if the node was already in the grid.
+*/
+bool ENG_API Eng::PickGrid::add(Node* node) {
+   if (cellOfNode.count(node))
+      return false;
+
+   if (cellSize <= 0.0f)
+      cellSize = minCellSize;
+   const unsigned long long key = keyOf(node->getWorldCenter());
+   cells[key].push_back(node);
+   cellOfNode.emplace(node, key);
+   maxRadius = std::max(maxRadius, node->getWorldRadius());
+   node->setPickGrid(this);
+   markMoved(node);
+   return true;
+}
+
+/**
+* @brief Remove a node
+*
+* @param node The node to remove.
+* @return False if the node was not in the grid.
+*/
+bool ENG_API Eng::PickGrid::remove(Node* node) {
+   auto entry = cellOfNode.find(node);
+   if (entry == cellOfNode.end())
+      return false;
+
+   auto cell = cells.find(entry->second);
+   std::vector<Node*>& nodes = cell->second;
+   *std::find(nodes.begin(), nodes.end(), node) = nodes.back();
+   nodes.pop_back();
+   if (nodes.empty())
+      cells.erase(cell);
+   cellOfNode.erase(entry);
+   node->setPickGrid(nullptr);
+   moved.erase(std::remove(moved.begin(), moved.end(), node), moved.end());
+   return true;
+}
+
+/**
+* @brief Remove all the nodes
+*/
+void ENG_API Eng::PickGrid::clear() {
+   for (const auto& entry : cellOfNode)
+      entry.first->setPickGrid(nullptr);
+   cells.clear();
+   cellOfNode.clear();
+   moved.clear();
+   maxRadius = 0.0f;
+}
+
+/**
+* @brief Move the nodes whose world bounds changed cell
+*
+* Only the nodes reported by markMoved() are re-binned. The largest radius only grows between
+* rebuilds: the queries stay correct, just a little wider, after the largest node shrinks.
+* The grid is rebuilt when the largest radius no longer fits the automatic cell size.
+*/
+void ENG_API Eng::PickGrid::refresh() {
+   if (moved.empty())
+      return;
+
+   for (Node* node : moved)
+      if (cellOfNode.count(node))
+         maxRadius = std::max(maxRadius, node->getWorldRadius());
+
+   // The automatic size follows the pieces: one piece diameter per cell
+   if (autoCellSize) {
+      const float size = std::max(minCellSize, maxRadius * 2.0f);
+      if (size > cellSize * 1.5f) {
+         cellSize = size;
+         rebuild();
+         moved.clear();
+         return;
+      }
+   }
+
+   // A node updated twice is found in its new cell the second time:
+   for (Node* node : moved) {
+      auto entry = cellOfNode.find(node);
+      if (entry == cellOfNode.end())
+         continue;
+      const unsigned long long key = keyOf(node->getWorldCenter());
+      if (key == entry->second)
+         continue;
+
+      std::vector<Node*>& from = cells[entry->second];
+      *std::find(from.begin(), from.end(), node) = from.back();
+      from.pop_back();
+      if (from.empty())
+         cells.erase(entry->second);
+      cells[key].push_back(node);
+      entry->second = key;
+   }
+   moved.clear();
+}
+
+/**
+* @brief Report a node whose world bounds changed
+*
+* Called by Node::updateWorldBounds(), possibly from the update workers.
+*
+* @param node The node.
+*/
+void ENG_API Eng::PickGrid::markMoved(Node* node) {
+   std::lock_guard<std::mutex> lock(movedMutex);
+   moved.push_back(node);
+}
+
+/**
+* @brief Set the cell size
+*
+* @param size The cell edge in world units, 0 for the automatic size.
+*/
+void ENG_API Eng::PickGrid::setCellSize(float size) {
+   autoCellSize = size <= 0.0f;
+   cellSize = autoCellSize ? std::max(minCellSize, maxRadius * 2.0f) : size;
+   rebuild();
+}
+
+/**
+* @brief Find the nodes whose bounding sphere intersects a sphere
+*
+* @param point The sphere center.
+* @param radius The sphere radius.
+* @param result The nodes found, appended.
+* @return The number of nodes found.
+*/
+unsigned int ENG_API Eng::PickGrid::queryRadius(const glm::vec3& point, float radius, std::vector<Node*>& result) const {
+   unsigned int found = 0;
+   visitRange(point, radius + maxRadius, [&](Node* node) {
+      const float reach = radius + node->getWorldRadius();
+      const glm::vec3 offset = node->getWorldCenter() - point;
+      if (glm::dot(offset, offset) <= reach * reach) {
+         result.push_back(node);
+         found++;
+      }
+   });
+   return found;
+}
+
+/**
+* @brief Find the nearest node within reach of a point
+*
+* A node is within reach when the point is closer to its world center than its world radius
+* multiplied by radiusScale.
+*
+* @param point The query point.
+* @param radiusScale The reach of the nodes, in bounding radii.
+* @param exclude Nodes to skip (e.g. the nodes held by the other hand).
+* @return The nearest node within reach, nullptr if none.
+*/
+Eng::Node ENG_API* Eng::PickGrid::findNearest(const glm::vec3& point, float radiusScale, std::span<Node* const> exclude) const {
+   Node* nearest = nullptr;
+   float nearestDistance = FLT_MAX;
+   visitRange(point, maxRadius * radiusScale, [&](Node* node) {
+      const glm::vec3 offset = node->getWorldCenter() - point;
+      const float distance = glm::dot(offset, offset);
+      const float reach = node->getWorldRadius() * radiusScale;
+      if (distance > reach * reach || distance >= nearestDistance)
+         return;
+      if (std::find(exclude.begin(), exclude.end(), node) != exclude.end())
+         return;
+      nearest = node;
+      nearestDistance = distance;
+   });
+   return nearest;
+}
+
+/**
+* @brief Get the key of the cell containing a point
+*
+* @param point The point.
+* @return The cell key.
+*/
+unsigned long long Eng::PickGrid::keyOf(const glm::vec3& point) const {
+   return keyOf(glm::ivec3(glm::floor(point / cellSize)));
+}
+
+/**
+* @brief Get the key of a cell from its coordinates
+*
+* 21 bits per axis.
+*
+* @param cell The cell coordinates.
+* @return The cell key.
+*/
+unsigned long long Eng::PickGrid::keyOf(const glm::ivec3& cell) {
+   const unsigned long long mask = (1ull << 21) - 1;
+   return ((unsigned long long)cell.x & mask) | (((unsigned long long)cell.y & mask) << 21) | (((unsigned long long)cell.z & mask) << 42);
+}
+
+/**
+* @brief Visit the nodes of the cells overlapping a box around a point
+*
+* When the box covers more cells than are occupied, the occupied cells are scanned instead.
+*
+* @param point The box center.
+* @param reach The box half size.
+* @param visitor Callable taking a Node*.
+*/
+template <typename Visitor>
+void Eng::PickGrid::visitRange(const glm::vec3& point, float reach, Visitor&& visitor) const {
+   if (cells.empty())
+      return;
+
+   const glm::ivec3 first(glm::floor((point - reach) / cellSize));
+   const glm::ivec3 last(glm::floor((point + reach) / cellSize));
+   const glm::dvec3 extent = glm::dvec3(last - first) + 1.0;
+   if (extent.x * extent.y * extent.z > (double)cells.size()) {
+      for (const auto& cell : cells)
+         for (Node* node : cell.second)
+            visitor(node);
+      return;
+   }
+
+   for (int z = first.z; z <= last.z; z++)
+      for (int y = first.y; y <= last.y; y++)
+         for (int x = first.x; x <= last.x; x++) {
+            auto cell = cells.find(keyOf(glm::ivec3(x, y, z)));
+            if (cell == cells.end())
+               continue;
+            for (Node* node : cell->second)
+               visitor(node);
+         }
+}
+
+/**
+* @brief Bin all the nodes again with the current cell size
+*/
+void Eng::PickGrid::rebuild() {
+   cells.clear();
+   maxRadius = 0.0f;
+   for (auto& entry : cellOfNode) {
+      maxRadius = std::max(maxRadius, entry.first->getWorldRadius());
+      entry.second = keyOf(entry.first->getWorldCenter());
+      cells[entry.second].push_back(entry.first);
+   }
+}
@@ -0,0 +1,163 @@
+/**
+* @file pickGrid.h
+* @brief PickGrid class header file
+*
+* This file contains the definition of the PickGrid class, the broadphase spatial index of the pickable
+* nodes used by the Leap Motion grab queries.
+*
+* @date 2025
+*
+* @details Loose uniform grid: every node is stored in the single cell containing the center of its
+* world bounding sphere, and the queries widen their range by the largest radius. Only the occupied cells
+* are allocated (hash map), so the grid adapts to the board and to the rest of the room.
+* The cell size defaults to the diameter of the largest pickable node.
+* @see Eng::List, Eng::Leap
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+
+#ifndef PICK_GRID_H
+#define PICK_GRID_H
+
+#include "engine.h"
+
+/**
+* @brief PickGrid class
+*
+* Loose hashed grid over the world bounding spheres of a set of nodes.
+*/
+class ENG_API PickGrid {
+public:
+   /**
+   * @brief Constructor
+   *
+   * Initializes an empty grid.
+   */
+   PickGrid() {};
+
+   /**
+   * @brief Add a node
+   *
+   * The node is binned with its current world bounds and checked again by the next refresh().
+   *
+   * @param node The node to add.
+   * @return False if the node was already in the grid.
+   */
+   bool add(Eng::Node* node);
+
+   /**
+   * @brief Remove a node
+   *
+   * @param node The node to remove.
+   * @return False if the node was not in the grid.
+   */
+   bool remove(Eng::Node* node);
+
+   /**
+   * @brief Remove all the nodes
+   */
+   void clear();
+
+   /**
+   * @brief Move the nodes whose world bounds changed cell
+   *
+   * Only the nodes reported by markMoved() since the last refresh are re-binned. The grid is
+   * rebuilt when the largest radius no longer fits the automatic cell size.
+   * Must not run concurrently with the world update.
+   */
+   void refresh();
+
+   /**
+   * @brief Report a node whose world bounds changed
+   *
+   * Called by Node::updateWorldBounds(), possibly from the update workers.
+   *
+   * @param node The node.
+   */
+   void markMoved(Eng::Node* node);
+
+   /**
+   * @brief Set the cell size
+   *
+   * @param size The cell edge in world units, 0 for the automatic size.
+   */
+   void setCellSize(float size);
+
+   /**
+   * @brief Find the nodes whose bounding sphere intersects a sphere
+   *
+   * @param point The sphere center.
+   * @param radius The sphere radius.
+   * @param result The nodes found, appended.
+   * @return The number of nodes found.
+   */
+   unsigned int queryRadius(const glm::vec3& point, float radius, std::vector<Eng::Node*>& result) const;
+
+   /**
+   * @brief Find the nearest node within reach of a point
+   *
+   * A node is within reach when the point is closer to its world center than its world radius
+   * multiplied by radiusScale.
+   *
+   * @param point The query point.
+   * @param radiusScale The reach of the nodes, in bounding radii.
+   * @param exclude Nodes to skip (e.g. the nodes held by the other hand).
+   * @return The nearest node within reach, nullptr if none.
+   */
+   Eng::Node* findNearest(const glm::vec3& point, float radiusScale, std::span<Eng::Node* const> exclude = {}) const;
+
+   /**
+   * @brief Get the number of nodes
+   *
+   * @return The number of nodes.
+   */
+   unsigned int size() const { return (unsigned int)cellOfNode.size(); }
+
+private:
+   /**
+   * @brief Get the key of the cell containing a point
+   *
+   * @param point The point.
+   * @return The cell key.
+   */
+   unsigned long long keyOf(const glm::vec3& point) const;
+
+   /**
+   * @brief Get the key of a cell from its coordinates
+   *
+   * @param cell The cell coordinates.
+   * @return The cell key.
+   */
+   static unsigned long long keyOf(const glm::ivec3& cell);
+
+   /**
+   * @brief Visit the nodes of the cells overlapping a box around a point
+   *
+   * When the box covers more cells than are occupied, the occupied cells are scanned instead.
+   *
+   * @param point The box center.
+   * @param reach The box half size.
+   * @param visitor Callable taking a Node*.
+   */
+   template <typename Visitor>
+   void visitRange(const glm::vec3& point, float reach, Visitor&& visitor) const;
+
+   /**
+   * @brief Bin all the nodes again with the current cell size
+   */
+   void rebuild();
+
+   float cellSize = 0.0f; /**< The cell edge in use */
+   bool autoCellSize = true; /**< True to derive the cell size from the largest radius */
+   float maxRadius = 0.0f; /**< The largest world radius of the nodes */
+   std::unordered_map<unsigned long long, std::vector<Eng::Node*>> cells; /**< The occupied cells */
+   std::unordered_map<Eng::Node*, unsigned long long> cellOfNode; /**< The cell of every node */
+   std::vector<Eng::Node*> moved; /**< The nodes whose bounds changed since the last refresh */
+   std::mutex movedMutex; /**< Guards the moved nodes against the update workers */
+};
+
+#endif // PICK_GRID_H
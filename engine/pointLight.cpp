@@ -37,34 +37,45 @@
  */
 ENG_API Eng::PointLight::PointLight(const std::string name, const int lightNumber, const glm::vec3 ambient,
 	const glm::vec3 diffuse, const glm::vec3 specular, const float cutOff) :
-	Light{ name, lightNumber, ambient, diffuse, specular }, cutOff(cutOff) {};
+	Light{ name, lightNumber, ambient, diffuse, specular, ObjectType::LIGHT_POINT }, cutOff(cutOff) {};
 
 /**
- * @brief Render the PointLight.
- *
- * @param transform The transform matrix.
- * @param data Other data.
- *
- * @return True if the render is succesful.
- */
-bool ENG_API Eng::PointLight::render(glm::mat4 inverseCamera, void* ptr) {
-
-	glm::vec4 worldCoordinates = glm::vec4(getPosition(), 1.0f);
-	glm::vec3 lightEyeCoordinates = inverseCamera * worldCoordinates;
+    * @brief Get the light cutOff
+    *
+    * @return The light cutOff.
+    */
+float ENG_API Eng::PointLight::getCutoff() const {
+	return cutOff;
+}
 
-	Shader::getCurrentShader()->setVec3("lightPosition", lightEyeCoordinates);
-	Shader::getCurrentShader()->setVec3("lightAmbient", getAmbient());
-	Shader::getCurrentShader()->setVec3("lightDiffuse", getDiffuse());
-	Shader::getCurrentShader()->setVec3("lightSpecular", getSpecular());
+/**
+    * @brief Check whether the light reaches a bounding sphere
+    *
+    * Sphere against the influence sphere of the light.
+    *
+    * @param center The world center of the sphere.
+    * @param radius The world radius of the sphere.
+    * @return True if the spheres overlap or the radius is unlimited.
+    */
+bool ENG_API Eng::PointLight::affects(const glm::vec3& center, float radius) {
+	const float range = getWorldInfluenceRadius();
+	if (range <= 0.0f)
+		return true;
 
-	return true;
+	const glm::vec3 offset = center - glm::vec3(getFinalMatrix()[3]);
+	const float reach = range + radius;
+	return glm::dot(offset, offset) <= reach * reach;
 }
 
 /**
-    * @brief Get the light cutOff
+    * @brief Get a world sphere enclosing the influence of the light
     *
-    * @return The light cutOff.
+    * @param center The world center of the sphere.
+    * @param radius The world radius of the sphere.
+    * @return False if the radius is unlimited.
     */
-float ENG_API Eng::PointLight::getCutoff() const {
-	return cutOff;
+bool ENG_API Eng::PointLight::getInfluenceSphere(glm::vec3& center, float& radius) {
+	radius = getWorldInfluenceRadius();
+	center = glm::vec3(getFinalMatrix()[3]);
+	return radius > 0.0f;
 }
\ No newline at end of file
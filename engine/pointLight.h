@@ -52,21 +52,31 @@ public:
    ~PointLight() {};
 
    /**
-    * @brief Render the PointLight.
+    * @brief Get the light cutOff
+    *
+    * @return The light cutOff.
+    */
+   float getCutoff() const;
+
+   /**
+    * @brief Check whether the light reaches a bounding sphere
     *
-    * @param transform The transform matrix.
-    * @param data Other data.
+    * Sphere against the influence sphere of the light.
     *
-    * @return True if the render is succesful.
+    * @param center The world center of the sphere.
+    * @param radius The world radius of the sphere.
+    * @return True if the spheres overlap or the radius is unlimited.
     */
-   virtual bool render(glm::mat4 transform, void* data) override;
+   bool affects(const glm::vec3& center, float radius) override;
 
    /**
-    * @brief Get the light cutOff
+    * @brief Get a world sphere enclosing the influence of the light
     *
-    * @return The light cutOff.
+    * @param center The world center of the sphere.
+    * @param radius The world radius of the sphere.
+    * @return False if the radius is unlimited.
     */
-   float getCutoff() const;
+   bool getInfluenceSphere(glm::vec3& center, float& radius) override;
 
 // Private methods and fields
 private:
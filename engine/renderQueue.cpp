@@ -0,0 +1,170 @@
+/**
+* @file renderQueue.cpp
+* @brief Implementation of the RenderQueue class
+*
+* This file contains the implementation of the RenderQueue class methods.
+*
+* @see RenderQueue
+* @see renderQueue.h
+*
+* @date 2025
+*
+* @details Keys: pass (8), shader (4), material (14), texture (12), VAO (10), depth (16).
+* The material is its block slot: the mesh copies of a material, and materials with the same
+* colors, share it. The identifiers are folded to their field width: a collision only costs a state change.
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+#include <GL/glew.h>
+#include "engine.h"
+
+/**
+* @brief Remove all the items
+*/
+void ENG_API Eng::RenderQueue::clear() {
+   items.clear();
+   depths.clear();
+}
+
+/**
+* @brief Add a draw
+*
+* @param mesh The mesh.
+* @param pass The pass, submitted in increasing order (up to 256 passes).
+* @param depth The view depth of the mesh, quantized by sort().
+*/
+void ENG_API Eng::RenderQueue::push(Mesh* mesh, unsigned int pass, float depth) {
+   Material* material = mesh->getMaterial();
+   Texture* texture = material->getTexture();
+   Shader* shader = Shader::getCurrentShader();
+
+   unsigned long long key = (unsigned long long)std::min(pass, 255u) << 56;
+   key |= (unsigned long long)(shader != nullptr ? shader->getId() & 0xF : 0) << 52;
+   key |= (unsigned long long)(material->getBlockSlot() & 0x3FFF) << 38;
+   key |= (unsigned long long)(texture != nullptr ? texture->getId() & 0xFFF : 0) << 26;
+   key |= (unsigned long long)(mesh->getVao() & 0x3FF) << 16;
+   items.push_back({ key, mesh });
+   depths.push_back(depth);
+}
+
+/**
+* @brief Sort the items by key
+*
+* The depths are quantized over the range of the queued items, then the keys are radix sorted
+* 8 bits at a time (least significant first). The digits shared by all the keys are skipped.
+*/
+void ENG_API Eng::RenderQueue::sort() {
+   const unsigned int count = (unsigned int)items.size();
+   if (count == 0)
+      return;
+
+   // Front-to-back: nearest first
+   const auto [minDepth, maxDepth] = std::minmax_element(depths.begin(), depths.end());
+   const float range = *maxDepth - *minDepth;
+   const float scale = range > 0.0f ? 65535.0f / range : 0.0f;
+   for (unsigned int i = 0; i < count; i++)
+      items[i].key |= (unsigned long long)((depths[i] - *minDepth) * scale);
+   depths.clear();
+
+   unsigned int histograms[8][256] = {};
+   for (const RenderItem& item : items)
+      for (unsigned int digit = 0; digit < 8; digit++)
+         histograms[digit][(item.key >> (digit * 8)) & 0xFF]++;
+
+   scratch.resize(count);
+   for (unsigned int digit = 0; digit < 8; digit++) {
+      unsigned int* histogram = histograms[digit];
+      const unsigned int shift = digit * 8;
+      if (histogram[(items[0].key >> shift) & 0xFF] == count)
+         continue;
+
+      unsigned int offset = 0;
+      for (unsigned int bucket = 0; bucket < 256; bucket++) {
+         const unsigned int size = histogram[bucket];
+         histogram[bucket] = offset;
+         offset += size;
+      }
+      for (const RenderItem& item : items)
+         scratch[histogram[(item.key >> shift) & 0xFF]++] = item;
+      items.swap(scratch);
+   }
+}
+
+/**
+* @brief Start a submission
+*
+* Forgets the state of the previous submission: other renderers may have changed it.
+*/
+void ENG_API Eng::RenderQueue::begin() {
+   lastTexture = nullptr;
+   lastMaterialSlot = -1;
+   lastVao = 0;
+}
+
+/**
+* @brief Draw an item
+*
+* Same state and draw call as Mesh::render(), without the repeated state changes.
+*
+* @param item The item.
+* @param view The view matrix.
+*/
+void ENG_API Eng::RenderQueue::draw(const RenderItem& item, const glm::mat4& view) {
+   Mesh* mesh = item.mesh;
+   Material* material = mesh->getMaterial();
+   Texture* texture = material->getTexture();
+   Shader* shader = Shader::getCurrentShader();
+
+   if (texture != nullptr) {
+      if (texture != lastTexture) {
+         texture->render(glm::mat4(1.0f), nullptr);
+         lastTexture = texture;
+         stats.textureBinds++;
+      }
+      else
+         stats.textureBindsSaved++;
+   }
+
+   const int materialSlot = (int)material->getBlockSlot();
+   if (materialSlot != lastMaterialSlot) {
+      UniformBuffers::bindMaterial(materialSlot);
+      lastMaterialSlot = materialSlot;
+      stats.materialBinds++;
+   }
+   else
+      stats.materialBindsSaved++;
+
+   const glm::mat4 modelView = view * mesh->getFinalMatrix();
+   shader->setMatrix(Shader::UNIFORM_MODELVIEW, modelView);
+   shader->setMatrix3(Shader::UNIFORM_NORMAL_MATRIX, glm::inverseTranspose(glm::mat3(modelView)));
+
+   // Mesh::render() binds and unbinds every time:
+   if (mesh->getVao() != lastVao) {
+      GlState::bindVertexArray(mesh->getVao());
+      lastVao = mesh->getVao();
+      stats.vaoBinds++;
+      stats.vaoBindsSaved++;
+   }
+   else
+      stats.vaoBindsSaved += 2;
+   glDrawElements(GL_TRIANGLES, mesh->getFacesCount(), GL_UNSIGNED_INT, nullptr);
+   stats.draws++;
+}
+
+/**
+* @brief End a submission
+*
+* Unbinds the VAO.
+*/
+void ENG_API Eng::RenderQueue::end() {
+   if (lastVao != 0) {
+      GlState::bindVertexArray(0);
+      lastVao = 0;
+      stats.vaoBinds++;
+      stats.vaoBindsSaved--;
+   }
+}
@@ -0,0 +1,151 @@
+/**
+* @file renderQueue.h
+* @brief RenderQueue class header file
+*
+* This file contains the definition of the RenderQueue class, which orders the draws of a view
+* to minimize the OpenGL state changes.
+*
+* @date 2025
+*
+* @details Every draw is described by a 64-bit key, from the most to the least significant bits:
+* pass (8), shader (4), material (14), texture (12), VAO (10) and quantized view depth (16).
+* The keys are radix sorted, so the draws of a pass are grouped by state and, within a state,
+* submitted front-to-back for early-z. The submission skips the texture binds, material block binds
+* and VAO binds that repeat the previous draw, and counts what was saved.
+* @see Eng::List, Eng::Mesh
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include "engine.h"
+
+/**
+* @brief Draw of a mesh in a pass
+*/
+struct ENG_API RenderItem {
+   unsigned long long key; /**< The sort key */
+   Mesh* mesh; /**< The mesh */
+
+   /**
+   * @brief Get the pass of the draw
+   *
+   * @return The pass, the top 8 bits of the key.
+   */
+   unsigned int getPass() const { return (unsigned int)(key >> 56); }
+};
+
+/**
+* @brief State changes of the submitted draws
+*
+* The saved counters are measured against drawing every item on its own (texture bind,
+* material block bind, VAO bind and unbind per draw).
+*/
+struct ENG_API RenderStats {
+   unsigned int draws = 0; /**< Draw calls */
+   unsigned int textureBinds = 0; /**< Texture binds issued */
+   unsigned int textureBindsSaved = 0; /**< Texture binds skipped */
+   unsigned int materialBinds = 0; /**< Material blocks bound */
+   unsigned int materialBindsSaved = 0; /**< Material block binds skipped */
+   unsigned int vaoBinds = 0; /**< VAO binds issued, the final unbind included */
+   unsigned int vaoBindsSaved = 0; /**< VAO binds and unbinds skipped */
+};
+
+/**
+* @brief RenderQueue class
+*
+* Sorted draw list of a view.
+*/
+class ENG_API RenderQueue {
+public:
+   /**
+   * @brief Constructor
+   *
+   * Initializes an empty queue.
+   */
+   RenderQueue() {};
+
+   /**
+   * @brief Remove all the items
+   */
+   void clear();
+
+   /**
+   * @brief Add a draw
+   *
+   * @param mesh The mesh.
+   * @param pass The pass, submitted in increasing order (up to 256 passes).
+   * @param depth The view depth of the mesh, quantized by sort().
+   */
+   void push(Mesh* mesh, unsigned int pass, float depth);
+
+   /**
+   * @brief Sort the items by key
+   *
+   * The depths are quantized over the range of the queued items, then the keys are radix sorted.
+   */
+   void sort();
+
+   /**
+   * @brief Get the sorted items
+   *
+   * @return The items, in submission order after sort().
+   */
+   std::span<const RenderItem> getItems() const { return items; }
+
+   /**
+   * @brief Start a submission
+   *
+   * Forgets the state of the previous submission: other renderers may have changed it.
+   */
+   void begin();
+
+   /**
+   * @brief Draw an item
+   *
+   * The texture, the material block and the VAO are only set when they differ from the previous draw.
+   *
+   * @param item The item.
+   * @param view The view matrix.
+   */
+   void draw(const RenderItem& item, const glm::mat4& view);
+
+   /**
+   * @brief End a submission
+   *
+   * Unbinds the VAO.
+   */
+   void end();
+
+   /**
+   * @brief Reset the counters
+   *
+   * Called once per frame: the counters add up all the views and passes of the frame.
+   */
+   void resetStats() { stats = RenderStats(); }
+
+   /**
+   * @brief Get the counters
+   *
+   * @return The state changes since the last resetStats().
+   */
+   const RenderStats& getStats() const { return stats; }
+
+private:
+   std::vector<RenderItem> items; /**< The draws */
+   std::vector<RenderItem> scratch; /**< Radix sort buffer */
+   std::vector<float> depths; /**< The view depth of every item, until sort() */
+
+   Texture* lastTexture = nullptr; /**< Texture bound by the last draw */
+   int lastMaterialSlot = -1; /**< Material block bound by the last draw */
+   unsigned int lastVao = 0; /**< VAO bound by the last draw */
+   RenderStats stats; /**< The counters */
+};
+
+#endif // RENDER_QUEUE_H
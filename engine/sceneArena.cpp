@@ -0,0 +1,93 @@
+/**
+* @file sceneArena.cpp
+* @brief Implementation of the SceneArena class
+*
+* This file contains the implementation of the SceneArena class methods.
+*
+* @see SceneArena
+* @see sceneArena.h
+*
+* @date 2025
+*
+* @details Blocks are cache-line aligned; an allocation larger than the block size gets a block of its own.
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+#include "engine.h"
+
+/**
+* @brief Alignment of the blocks
+*/
+static constexpr size_t blockAlignment = 64;
+
+/**
+* @brief Constructor
+*
+* @param blockSize The size of the memory blocks, in bytes.
+*/
+ENG_API Eng::SceneArena::SceneArena(size_t blockSize) : blockSize(blockSize) {
+   destructors.reserve(256);
+}
+
+/**
+* @brief Destructor
+*
+* Destroys all the objects and frees the blocks.
+*/
+ENG_API Eng::SceneArena::~SceneArena() {
+   release();
+}
+
+/**
+* @brief Allocate raw memory in the arena
+*
+* @param size The size, in bytes.
+* @param alignment The alignment, at most the block alignment (64 bytes).
+* @return The memory.
+*/
+void ENG_API* Eng::SceneArena::allocate(size_t size, size_t alignment) {
+   size_t start = (offset + alignment - 1) & ~(alignment - 1);
+   if (blocks.empty() || start + size > blocks.back().size) {
+      const size_t newSize = std::max(size, blockSize);
+      blocks.push_back(Block{ (char*)::operator new(newSize, std::align_val_t(blockAlignment)), newSize });
+      start = 0;
+   }
+
+   offset = start + size;
+   bytesUsed += size;
+   return blocks.back().data + start;
+}
+
+/**
+* @brief Destroy all the objects and free the blocks
+*/
+void ENG_API Eng::SceneArena::release() {
+   for (auto it = destructors.rbegin(); it != destructors.rend(); it++)
+      it->destroy(it->object);
+   destructors.clear();
+
+   for (Block& block : blocks)
+      ::operator delete(block.data, std::align_val_t(blockAlignment));
+   blocks.clear();
+
+   offset = 0;
+   bytesUsed = 0;
+}
+
+/**
+* @brief Check if a pointer belongs to the arena
+*
+* @param ptr The pointer.
+* @return True if the pointer lies in one of the blocks.
+*/
+bool ENG_API Eng::SceneArena::owns(const void* ptr) const {
+   const char* p = (const char*)ptr;
+   for (const Block& block : blocks)
+      if (p >= block.data && p < block.data + block.size)
+         return true;
+   return false;
+}
@@ -0,0 +1,139 @@
+/**
+* @file sceneArena.h
+* @brief SceneArena class header file
+*
+* This file contains the definition of the SceneArena class, the block allocator that owns all the objects
+* created while loading a scene.
+*
+* @date 2025
+*
+* @details Objects are placed one after the other in large blocks, in creation order (the depth-first order of
+* the .ovo file), so related nodes end up adjacent in memory. Every object registers a destructor thunk:
+* releasing the arena destroys the objects in reverse order and frees the blocks in one go.
+* Only the object storage lives in the blocks: the members of the objects (names, vertex and face vectors,
+* texture pixels) still allocate on the global heap, and the counters do not include them.
+* @see Eng::OvoReader, Eng::List
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+
+#ifndef SCENE_ARENA_H
+#define SCENE_ARENA_H
+
+#include "engine.h"
+
+/**
+* @brief SceneArena class
+*
+* Bump allocator with typed destruction and counters of the object storage.
+*/
+class ENG_API SceneArena {
+public:
+   /**
+   * @brief Constructor
+   *
+   * @param blockSize The size of the memory blocks, in bytes.
+   */
+   SceneArena(size_t blockSize = 64 * 1024);
+
+   /**
+   * @brief Destructor
+   *
+   * Destroys all the objects and frees the blocks.
+   */
+   ~SceneArena();
+
+   SceneArena(const SceneArena&) = delete;
+   SceneArena& operator=(const SceneArena&) = delete;
+
+   /**
+   * @brief Construct an object in the arena
+   *
+   * The object is destroyed by release(), it must not be deleted.
+   *
+   * @param args The constructor arguments.
+   * @return The new object.
+   */
+   template <typename T, typename... Args>
+   T* create(Args&&... args) {
+      T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+      destructors.push_back(Destructor{ object, [](void* ptr) { static_cast<T*>(ptr)->~T(); } });
+      return object;
+   }
+
+   /**
+   * @brief Allocate raw memory in the arena
+   *
+   * @param size The size, in bytes.
+   * @param alignment The alignment, at most the block alignment (64 bytes).
+   * @return The memory.
+   */
+   void* allocate(size_t size, size_t alignment);
+
+   /**
+   * @brief Destroy all the objects and free the blocks
+   */
+   void release();
+
+   /**
+   * @brief Check if a pointer belongs to the arena
+   *
+   * @param ptr The pointer.
+   * @return True if the pointer lies in one of the blocks.
+   */
+   bool owns(const void* ptr) const;
+
+   /**
+   * @brief Get the number of objects constructed in the arena
+   *
+   * @return The number of live objects.
+   */
+   unsigned int getObjectCount() const { return (unsigned int)destructors.size(); }
+
+   /**
+   * @brief Get the number of blocks requested to the heap
+   *
+   * The allocations made by the objects themselves (strings, vectors) are not counted.
+   *
+   * @return The number of heap allocations made by the arena.
+   */
+   unsigned int getBlockCount() const { return (unsigned int)blocks.size(); }
+
+   /**
+   * @brief Get the number of bytes handed out
+   *
+   * The object storage only, see getBlockCount().
+   *
+   * @return The used bytes, padding included.
+   */
+   size_t getBytesUsed() const { return bytesUsed; }
+
+private:
+   /**
+   * @brief Memory block
+   */
+   struct Block {
+      char* data; /**< The block memory */
+      size_t size; /**< The block size */
+   };
+
+   /**
+   * @brief Destructor thunk of a constructed object
+   */
+   struct Destructor {
+      void* object; /**< The object */
+      void (*destroy)(void*); /**< Calls the destructor of the real type */
+   };
+
+   std::vector<Block> blocks; /**< The blocks, the last one is the current */
+   std::vector<Destructor> destructors; /**< The constructed objects, in creation order */
+   size_t blockSize; /**< Default block size */
+   size_t offset = 0; /**< First free byte of the current block */
+   size_t bytesUsed = 0; /**< Bytes handed out */
+};
+
+#endif // SCENE_ARENA_H
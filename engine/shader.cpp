@@ -24,6 +24,7 @@
 
 Eng::Shader* Eng::Shader::currentShader = nullptr;
 std::map<std::string, Eng::Shader*> Eng::Shader::shaders;
+Eng::UniformStats Eng::Shader::uniformStats;
 
 
 
@@ -35,7 +36,10 @@ std::map<std::string, Eng::Shader*> Eng::Shader::shaders;
 /**
  * Constructor.
  */
-Eng::Shader::Shader() : type(TYPE_UNDEFINED), glId(0){}
+Eng::Shader::Shader() : Object(ObjectType::SHADER), type(TYPE_UNDEFINED), glId(0)
+{
+   std::fill(std::begin(uniformSlots), std::end(uniformSlots), -1);
+}
 
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -53,7 +57,7 @@ Eng::Shader::~Shader()
          break;
 
       case TYPE_PROGRAM:
-         glDeleteProgram(glId);
+         GlState::deleteProgram(glId);
          break;
       }
 }
@@ -91,84 +95,190 @@ int Eng::Shader::getParamLocation(const char* name)
    return r;
 }
 
-void Eng::Shader::setMatrix(std::string param, const glm::mat4& mat) {
-   std::map<std::string, int>::iterator it = bindingMap.find(param);
-   if (it == bindingMap.end()) {
-      // Se il parametro non  presente, creiamo un nuovo binding
-      int newId = getParamLocation(param.c_str());
-      bindingMap.emplace(param, newId);
-      glUniformMatrix4fv(newId, 1, GL_FALSE, glm::value_ptr(mat));
-   }
-   else {
-      // Se il parametro esiste gi, usiamo l'ID associato
-      glUniformMatrix4fv(it->second, 1, GL_FALSE, glm::value_ptr(mat));
-   }
+/**
+ * Uniform names, per identifier.
+ */
+static const char* uniformNames[Eng::Shader::UNIFORM_LAST] = { "projection", "modelview", "normalMatrix", "color" };
+
+/**
+ * Returns the GLSL name of a uniform identifier.
+ * @param param uniform identifier
+ * @return uniform name
+ */
+const char* Eng::Shader::getUniformName(Uniform param)
+{
+   return uniformNames[param];
 }
-void Eng::Shader::setMatrix3(std::string param, const glm::mat3& mat) {
+
+/**
+ * Returns the location of a uniform given its name. The names missing from the reflected
+ * uniforms are resolved once and cached, the error is reported once.
+ * @param param uniform name
+ * @return location ID or -1 if not found
+ */
+int Eng::Shader::locate(const std::string& param)
+{
    std::map<std::string, int>::iterator it = bindingMap.find(param);
-   if (it == bindingMap.end()) {
-      // Se il parametro non  presente, creiamo un nuovo binding
-      int newId = getParamLocation(param.c_str());
-      bindingMap.emplace(param, newId);
-      glUniformMatrix3fv(newId, 1, GL_FALSE, glm::value_ptr(mat));
-   }
-   else {
-      // Se il parametro esiste gi, usiamo l'ID associato
-      glUniformMatrix3fv(it->second, 1, GL_FALSE, glm::value_ptr(mat));
-   }
+   if (it != bindingMap.end())
+      return it->second;
+   const int location = getParamLocation(param.c_str());
+   bindingMap.emplace(param, location);
+   return location;
 }
 
-void Eng::Shader::setFloat(std::string param, float value) {
-   std::map<std::string, int>::iterator it = bindingMap.find(param);
-   if (it == bindingMap.end()) {
-      // Se il parametro non  presente, creiamo un nuovo binding
-      int newId = getParamLocation(param.c_str());
-      bindingMap.emplace(param, newId);
-      glUniform1f(newId, value);
-   }
-   else {
-      // Se il parametro esiste gi, usiamo l'ID associato
-      glUniform1f(it->second, value);
+/**
+ * Reflects the active uniforms of the linked program into the binding map and resolves the
+ * slot of every engine uniform. Members of uniform blocks have no location and are skipped.
+ */
+void Eng::Shader::reflectUniforms()
+{
+   bindingMap.clear();
+   uniformShadows.clear();
+
+   int count = 0;
+   glGetProgramiv(glId, GL_ACTIVE_UNIFORMS, &count);
+   for (int i = 0; i < count; i++)
+   {
+      char name[256];
+      GLsizei length = 0;
+      GLint size = 0;
+      GLenum type = 0;
+      glGetActiveUniform(glId, (GLuint)i, sizeof(name), &length, &size, &type, name);
+
+      // Arrays are reported as "name[0]":
+      std::string uniform(name, length);
+      if (uniform.size() > 3 && uniform.compare(uniform.size() - 3, 3, "[0]") == 0)
+         uniform.resize(uniform.size() - 3);
+
+      const int location = glGetUniformLocation(glId, uniform.c_str());
+      if (location >= 0)
+      {
+         bindingMap.emplace(uniform, location);
+         if ((size_t)location >= uniformShadows.size())
+            uniformShadows.resize(location + 1);
+      }
    }
+   resolveSlots();
 }
-void Eng::Shader::setInt(std::string param, int value) {
-   std::map<std::string, int>::iterator it = bindingMap.find(param);
-   if (it == bindingMap.end()) {
-      // Se il parametro non  presente, creiamo un nuovo binding
-      int newId = getParamLocation(param.c_str());
-      bindingMap.emplace(param, newId);
-      glUniform1f(newId, value);
-   }
-   else {
-      // Se il parametro esiste gi, usiamo l'ID associato
-      glUniform1f(it->second, value);
+
+/**
+ * Resolves the slot of every engine uniform from the binding map, -1 if not active.
+ */
+void Eng::Shader::resolveSlots()
+{
+   std::fill(std::begin(uniformSlots), std::end(uniformSlots), -1);
+   for (int i = 0; i < UNIFORM_LAST; i++)
+   {
+      std::map<std::string, int>::iterator it = bindingMap.find(uniformNames[i]);
+      if (it != bindingMap.end())
+         uniformSlots[i] = it->second;
    }
 }
-void Eng::Shader::setVec3(std::string param, const glm::vec3& vect) {
-   std::map<std::string, int>::iterator it = bindingMap.find(param);
-   if (it == bindingMap.end()) {
-      // Se il parametro non  presente, creiamo un nuovo binding
-      int newId = getParamLocation(param.c_str());
-      bindingMap.emplace(param, newId);
-      glUniform3fv(newId, 1, glm::value_ptr(vect));
+
+/**
+ * Compares a value with the last one uploaded to the location and records it. Uniform values
+ * belong to the program: the shadow stays valid across program switches.
+ * @param location uniform location, -1 if not active
+ * @param value pointer to the value
+ * @param size size of the value in bytes, up to a 4x4 matrix
+ * @return true if the value must be uploaded
+ */
+bool Eng::Shader::changed(int location, const void* value, unsigned int size)
+{
+   if (location < 0)
+      return false;
+   if ((size_t)location >= uniformShadows.size())
+      uniformShadows.resize(location + 1);
+
+   UniformShadow& shadow = uniformShadows[location];
+   if (shadow.size == size && memcmp(shadow.value, value, size) == 0)
+   {
+      uniformStats.hits++;
+      return false;
    }
-   else {
-      // Se il parametro esiste gi, usiamo l'ID associato
-      glUniform3fv(it->second, 1, glm::value_ptr(vect));
-   }   
+   memcpy(shadow.value, value, size);
+   shadow.size = size;
+   uniformStats.misses++;
+   return true;
 }
-void Eng::Shader::setVec4(std::string param, const glm::vec4& vect) {
-   std::map<std::string, int>::iterator it = bindingMap.find(param);
-   if (it == bindingMap.end()) {
-      // Se il parametro non  presente, creiamo un nuovo binding
-      int newId = getParamLocation(param.c_str());
-      bindingMap.emplace(param, newId);
-      glUniform4fv(newId, 1, glm::value_ptr(vect));
-   }
-   else {
-      // Se il parametro esiste gi, usiamo l'ID associato
-      glUniform4fv(it->second, 1, glm::value_ptr(vect));
-   }
+
+/**
+ * Returns the uniform shadow counters of all the programs.
+ * @return sets skipped and uploaded since the last reset
+ */
+const Eng::UniformStats& Eng::Shader::getUniformStats()
+{
+   return uniformStats;
+}
+
+/**
+ * Resets the uniform shadow counters.
+ */
+void Eng::Shader::resetUniformStats()
+{
+   uniformStats = UniformStats();
+}
+
+void Eng::Shader::setMatrix(const std::string& param, const glm::mat4& mat) {
+   const int location = locate(param);
+   if (changed(location, glm::value_ptr(mat), sizeof(mat)))
+      glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat));
+}
+void Eng::Shader::setMatrix3(const std::string& param, const glm::mat3& mat) {
+   const int location = locate(param);
+   if (changed(location, glm::value_ptr(mat), sizeof(mat)))
+      glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(mat));
+}
+void Eng::Shader::setFloat(const std::string& param, float value) {
+   const int location = locate(param);
+   if (changed(location, &value, sizeof(value)))
+      glUniform1f(location, value);
+}
+void Eng::Shader::setInt(const std::string& param, int value) {
+   const int location = locate(param);
+   if (changed(location, &value, sizeof(value)))
+      glUniform1i(location, value);
+}
+void Eng::Shader::setVec3(const std::string& param, const glm::vec3& vect) {
+   const int location = locate(param);
+   if (changed(location, glm::value_ptr(vect), sizeof(vect)))
+      glUniform3fv(location, 1, glm::value_ptr(vect));
+}
+void Eng::Shader::setVec4(const std::string& param, const glm::vec4& vect) {
+   const int location = locate(param);
+   if (changed(location, glm::value_ptr(vect), sizeof(vect)))
+      glUniform4fv(location, 1, glm::value_ptr(vect));
+}
+
+void Eng::Shader::setMatrix(Uniform param, const glm::mat4& mat) {
+   const int location = uniformSlots[param];
+   if (changed(location, glm::value_ptr(mat), sizeof(mat)))
+      glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat));
+}
+void Eng::Shader::setMatrix3(Uniform param, const glm::mat3& mat) {
+   const int location = uniformSlots[param];
+   if (changed(location, glm::value_ptr(mat), sizeof(mat)))
+      glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(mat));
+}
+void Eng::Shader::setFloat(Uniform param, float value) {
+   const int location = uniformSlots[param];
+   if (changed(location, &value, sizeof(value)))
+      glUniform1f(location, value);
+}
+void Eng::Shader::setInt(Uniform param, int value) {
+   const int location = uniformSlots[param];
+   if (changed(location, &value, sizeof(value)))
+      glUniform1i(location, value);
+}
+void Eng::Shader::setVec3(Uniform param, const glm::vec3& vect) {
+   const int location = uniformSlots[param];
+   if (changed(location, glm::value_ptr(vect), sizeof(vect)))
+      glUniform3fv(location, 1, glm::value_ptr(vect));
+}
+void Eng::Shader::setVec4(Uniform param, const glm::vec4& vect) {
+   const int location = uniformSlots[param];
+   if (changed(location, glm::value_ptr(vect), sizeof(vect)))
+      glUniform4fv(location, 1, glm::value_ptr(vect));
 }
 
 void Eng::Shader::bind(int location, const char* attribName) {
@@ -337,7 +447,7 @@ bool Eng::Shader::build(Shader* vertexShader, Shader* fragmentShader)
          std::cout << "[ERROR] Cannot reload a shader as a program" << std::endl;
          return false;
       }
-      glDeleteProgram(glId);
+      GlState::deleteProgram(glId);
    }
 
    // Create program:
@@ -381,6 +491,9 @@ bool Eng::Shader::build(Shader* vertexShader, Shader* fragmentShader)
       return false;
    }
 
+   // Uniform locations, resolved once:
+   reflectUniforms();
+
    // Done:
    return true;
 }
@@ -424,7 +537,7 @@ bool Eng::Shader::render(void* data)
 {
    // Activate shader:
    if (glId)
-      glUseProgram(glId);
+      GlState::useProgram(glId);
    else
    {
       std::cout << "[ERROR] Invalid shader rendered" << std::endl;
@@ -14,6 +14,17 @@
 
 
 
+/**
+ * @brief Uniform sets skipped and uploaded by the value shadow of the programs
+ */
+struct ENG_API UniformStats
+{
+   unsigned int hits = 0;   ///< Sets skipped: same value as the last upload
+   unsigned int misses = 0; ///< Sets uploaded to OpenGL
+};
+
+
+
 //////////////////
 // CLASS Shader //
 //////////////////
@@ -39,18 +50,68 @@ public: //
       TYPE_LAST
    };
 
+   enum Uniform ///< Uniforms set by the engine, resolved once by build()
+   {
+      UNIFORM_PROJECTION = 0,
+      UNIFORM_MODELVIEW,
+      UNIFORM_NORMAL_MATRIX,
+      UNIFORM_COLOR,
+      UNIFORM_LAST
+   };
+
    // Const/dest:	 
    Shader();
    ~Shader();
 
-   // Get/set:
+   // Get/set (the sets repeating the last uploaded value are skipped, see getUniformStats()):
    int getParamLocation(const char* name);
-   void setMatrix(std::string param, const glm::mat4& mat);
-   void setMatrix3(std::string param, const glm::mat3& mat);
-   void setFloat(std::string param, float value);
-   void setInt(std::string param, int value);
-   void setVec3(std::string param, const glm::vec3& vect);
-   void setVec4(std::string param, const glm::vec4& vect);
+   void setMatrix(const std::string& param, const glm::mat4& mat);
+   void setMatrix3(const std::string& param, const glm::mat3& mat);
+   void setFloat(const std::string& param, float value);
+   void setInt(const std::string& param, int value);
+   void setVec3(const std::string& param, const glm::vec3& vect);
+   void setVec4(const std::string& param, const glm::vec4& vect);
+
+   // Get/set by identifier, a lookup in the slot table (no-op if the program lacks the uniform):
+   void setMatrix(Uniform param, const glm::mat4& mat);
+   void setMatrix3(Uniform param, const glm::mat3& mat);
+   void setFloat(Uniform param, float value);
+   void setInt(Uniform param, int value);
+   void setVec3(Uniform param, const glm::vec3& vect);
+   void setVec4(Uniform param, const glm::vec4& vect);
+
+   /**
+    * @brief Get the GLSL name of a uniform identifier.
+    *
+    * @param param The identifier.
+    * @return The name.
+    */
+   static const char* getUniformName(Uniform param);
+
+   /**
+    * @brief Get the location of a uniform identifier.
+    *
+    * @param param The identifier.
+    * @return The location resolved by build(), -1 if the program lacks the uniform.
+    */
+   int getUniformLocation(Uniform param) const { return uniformSlots[param]; }
+
+   /**
+    * @brief Get the uniform shadow counters.
+    *
+    * Every setter compares the value with a CPU copy of the last upload to the same program and
+    * skips the glUniform* call when they are bitwise equal. The counters add up all the programs.
+    *
+    * @return The sets skipped and uploaded since the last resetUniformStats().
+    */
+   static const UniformStats& getUniformStats();
+
+   /**
+    * @brief Reset the uniform shadow counters.
+    *
+    * Called once per frame.
+    */
+   static void resetUniformStats();
 
    // Accessing data:
    bool loadFromMemory(int kind, const char* data);
@@ -104,7 +165,28 @@ private:	//
    // OGL id:
    unsigned int glId;
 
+   // The benchmarks time the lookups on a program reflected without GL:
+   friend class Benchmark;
+
+   // Uniforms reflected by build():
+   void reflectUniforms();
+   void resolveSlots();
+   int locate(const std::string& param);
+   bool changed(int location, const void* value, unsigned int size);
+
+   /**
+    * @brief Last value uploaded to a uniform location
+    */
+   struct UniformShadow
+   {
+      unsigned char value[sizeof(glm::mat4)]; ///< The value, up to a 4x4 matrix
+      unsigned int size = 0;                  ///< Size of the value, 0 if nothing was uploaded
+   };
+
    static Shader *currentShader; ///< Current shader
-   std::map<std::string, int> bindingMap; ///< Map of binding names and locations
+   std::map<std::string, int> bindingMap; ///< Map of binding names and locations, filled by build()
+   int uniformSlots[UNIFORM_LAST]; ///< Locations of the engine uniforms, -1 if not active
+   std::vector<UniformShadow> uniformShadows; ///< Last uploaded values, per location
+   static UniformStats uniformStats; ///< Shadow counters of all the programs
    static std::map<std::string, Shader*> shaders; ///< Map of shaders
 };
\ No newline at end of file
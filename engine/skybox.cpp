@@ -18,7 +18,14 @@
 const char* skyboxVertShader = R"(
    #version 440 core
 
-   uniform mat4 projection;
+   // Per-eye data (UniformBuffers::BINDING_FRAME):
+   layout(std140, binding = 0) uniform Frame
+   {
+      mat4 projection;
+      mat4 view;
+      vec4 eyePosition;
+   } frame;
+
    uniform mat4 modelview;
 
    layout(location = 0) in vec3 in_Position;
@@ -28,7 +35,7 @@ const char* skyboxVertShader = R"(
    void main(void)
    {
       texCoord = in_Position;
-      gl_Position = projection * modelview * vec4(in_Position, 1.0f);
+      gl_Position = frame.projection * modelview * vec4(in_Position, 1.0f);
       gl_Position = gl_Position.xyww;
    }
 )";
@@ -55,7 +62,7 @@ const char* skyboxFragShader = R"(
     *
     * Initializes a skybox with default values.
     */
-Eng::Skybox::Skybox(const std::string& name) : Node(name) {
+Eng::Skybox::Skybox(const std::string& name) : Node(name, ObjectType::SKYBOX) {
 
    Shader* skyboxVs = new Shader();
    skyboxVs->loadFromMemory(Shader::TYPE_VERTEX, skyboxVertShader);
@@ -122,7 +129,7 @@ void Eng::Skybox::setupSkybox(const std::string& face1, const std::string& face2
 void Eng::Skybox::buildCubemap() {
    // Create and bind cubemap:
    glGenTextures(1, &cubemapId);
-   glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapId);
+   GlState::bindTexture(GL_TEXTURE_CUBE_MAP, cubemapId);
 
    // Set params:
    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -160,7 +167,7 @@ void Eng::Skybox::buildCubemap() {
    }
 
    glGenVertexArrays(1, &globalVAO);
-   glBindVertexArray(globalVAO);
+   GlState::bindVertexArray(globalVAO);
 
    glGenBuffers(1, &cubeVboVertices);
    glBindBuffer(GL_ARRAY_BUFFER, cubeVboVertices);
@@ -175,11 +182,11 @@ void Eng::Skybox::buildCubemap() {
    glBufferData(GL_ELEMENT_ARRAY_BUFFER, cubeFaces.size() * sizeof(unsigned short), cubeFaces.data(), GL_STATIC_DRAW);
 }
 bool Eng::Skybox::render(glm::mat4 transform, void* data) {
-   glBindVertexArray(globalVAO);
-   glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapId);
-   Eng::Shader::getCurrentShader()->setMatrix("modelview", transform);
+   GlState::bindVertexArray(globalVAO);
+   GlState::bindTexture(GL_TEXTURE_CUBE_MAP, cubemapId);
+   Eng::Shader::getCurrentShader()->setMatrix(Eng::Shader::UNIFORM_MODELVIEW, transform);
 
    glDrawElements(GL_TRIANGLES, cubeFaces.size(), GL_UNSIGNED_SHORT, nullptr);
-   glBindVertexArray(0);
+   GlState::bindVertexArray(0);
    return true;
 }
\ No newline at end of file
@@ -38,31 +38,20 @@
     */
 ENG_API Eng::SpotLight::SpotLight(const std::string name, const int lightNumber, const glm::vec4 ambient,
 	const glm::vec4 diffuse, const glm::vec4 specular, const float cutOff, const glm::vec3 direction) :
-   Light{ name, lightNumber, ambient, diffuse, specular }, cutOff(cutOff) {
+   Light{ name, lightNumber, ambient, diffuse, specular, ObjectType::LIGHT_SPOT }, direction(direction), cutOff(cutOff) {
 };
 
 /**
-    * @brief Render the SpotLight.
+    * @brief Fill the uniform block of the light
     *
-    * @param transform The transform matrix.
-    * @param data Other data.
+    * Adds the world direction and the cosine of the cutoff.
     *
-    * @return True if the render is succesful.
+    * @param block The block to fill.
     */
-bool ENG_API Eng::SpotLight::render(glm::mat4 inverseCamera, void* ptr) {
-   glm::vec4 worldCoordinates = glm::vec4(getPosition(), 1.0f);
-   glm::vec3 lightEyeCoordinates = inverseCamera * worldCoordinates;
-   Shader::getCurrentShader()->setVec3("lightPosition", lightEyeCoordinates);
-   Shader::getCurrentShader()->setVec3("lightDirection", glm::normalize(getDirection()));
-   Shader::getCurrentShader()->setVec3("cameraPosition", lightEyeCoordinates);
-   Shader::getCurrentShader()->setVec3("lightAmbient", getAmbient());
-   Shader::getCurrentShader()->setVec3("lightDiffuse", getDiffuse());
-   Shader::getCurrentShader()->setVec3("lightSpecular", getSpecular());
-   Shader::getCurrentShader()->setFloat("lightCutoff", glm::cos(glm::radians(cutOff)));
-   Shader::getCurrentShader()->setFloat("lightConstant", getConstantAttenuation());
-   Shader::getCurrentShader()->setFloat("lightLinear", getLinearAttenuation());
-   Shader::getCurrentShader()->setFloat("lightQuadratic", getQuadraticAttenuation());
-	return true;
+void ENG_API Eng::SpotLight::getLightBlock(LightBlock& block) {
+   Light::getLightBlock(block);
+   block.direction = glm::vec4(glm::normalize(glm::mat3(getFinalMatrix()) * getDirection()), 0.0f);
+   block.attenuation.w = glm::cos(glm::radians(cutOff));
 }
 
 /**
@@ -72,4 +61,74 @@ bool ENG_API Eng::SpotLight::render(glm::mat4 inverseCamera, void* ptr) {
     */
 glm::vec3 ENG_API Eng::SpotLight::getDirection() const {
    return direction;
+}
+
+/**
+    * @brief Check whether the light reaches a bounding sphere
+    *
+    * Sphere against the cone of the light, capped by the influence radius.
+    * The distance of the sphere center from the cone surface is compared with the sphere radius.
+    *
+    * @param center The world center of the sphere.
+    * @param radius The world radius of the sphere.
+    * @return True if the sphere may touch the cone.
+    */
+bool ENG_API Eng::SpotLight::affects(const glm::vec3& center, float radius) {
+   const glm::mat4& world = getFinalMatrix();
+   const glm::vec3 offset = center - glm::vec3(world[3]);
+   const float distanceSquared = glm::dot(offset, offset);
+
+   const float range = getWorldInfluenceRadius();
+   if (range > 0.0f && distanceSquared > (range + radius) * (range + radius))
+      return false;
+
+   // Cones of 90 degrees or more cover a half space or more: the range test is enough
+   const glm::vec3 axis = glm::mat3(world) * direction;
+   if (cutOff >= 90.0f || glm::dot(axis, axis) == 0.0f)
+      return true;
+
+   const glm::vec3 dir = glm::normalize(axis);
+   const float along = glm::dot(offset, dir);
+   if (along < -radius)
+      return false;
+
+   const float angle = glm::radians(cutOff);
+   const float across = std::sqrt(std::max(distanceSquared - along * along, 0.0f));
+   return glm::cos(angle) * across - glm::sin(angle) * along <= radius;
+}
+
+/**
+    * @brief Get a world sphere enclosing the influence of the light
+    *
+    * Smallest sphere around the cone capped by the influence radius: narrow cones are bounded
+    * by the sphere through the apex and the base rim, wide cones by the sphere of the base disk.
+    *
+    * @param center The world center of the sphere.
+    * @param radius The world radius of the sphere.
+    * @return False if the radius is unlimited.
+    */
+bool ENG_API Eng::SpotLight::getInfluenceSphere(glm::vec3& center, float& radius) {
+   const float range = getWorldInfluenceRadius();
+   const glm::mat4& world = getFinalMatrix();
+   const glm::vec3 apex(world[3]);
+   const glm::vec3 axis = glm::mat3(world) * direction;
+   if (range <= 0.0f)
+      return false;
+
+   radius = range;
+   center = apex;
+   if (cutOff >= 90.0f || glm::dot(axis, axis) == 0.0f)
+      return true;
+
+   const glm::vec3 dir = glm::normalize(axis);
+   const float angle = glm::radians(cutOff);
+   if (cutOff > 45.0f) {
+      center = apex + dir * (range * glm::cos(angle));
+      radius = range * glm::sin(angle);
+   }
+   else {
+      radius = range / (2.0f * glm::cos(angle));
+      center = apex + dir * radius;
+   }
+   return true;
 }
\ No newline at end of file
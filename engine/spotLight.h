@@ -53,14 +53,13 @@ public:
 	~SpotLight() {};
 
    /**
-    * @brief Render the SpotLight.
+    * @brief Fill the uniform block of the light
     *
-    * @param transform The transform matrix.
-    * @param data Other data.
+    * Adds the world direction and the cosine of the cutoff.
     *
-    * @return True if the render is succesful.
+    * @param block The block to fill.
     */
-	bool render(glm::mat4 transform, void* data) override;
+   void getLightBlock(LightBlock& block) override;
 
    /**
     * @brief Get the light direction
@@ -69,6 +68,28 @@ public:
     */
    glm::vec3 getDirection() const;
 
+   /**
+    * @brief Check whether the light reaches a bounding sphere
+    *
+    * Sphere against the cone of the light, capped by the influence radius.
+    *
+    * @param center The world center of the sphere.
+    * @param radius The world radius of the sphere.
+    * @return True if the sphere may touch the cone.
+    */
+   bool affects(const glm::vec3& center, float radius) override;
+
+   /**
+    * @brief Get a world sphere enclosing the influence of the light
+    *
+    * Smallest sphere around the cone capped by the influence radius.
+    *
+    * @param center The world center of the sphere.
+    * @param radius The world radius of the sphere.
+    * @return False if the radius is unlimited.
+    */
+   bool getInfluenceSphere(glm::vec3& center, float& radius) override;
+
 // Private methods and fields
 private:
 	glm::vec3 direction; /**< The SpotLight direction */
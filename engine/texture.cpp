@@ -32,7 +32,7 @@
  *
  * @param name The name of the Texture.
  */
-ENG_API Eng::Texture::Texture(const std::string& name) : width(0), height(0) {
+ENG_API Eng::Texture::Texture(const std::string& name) : Object(ObjectType::TEXTURE), width(0), height(0) {
    Object::setId(Object::getNextId());
    Object::setName(name);
 }
@@ -55,8 +55,10 @@ ENG_API Eng::Texture::~Texture() {}
 bool ENG_API Eng::Texture::loadFromFile(const std::string& filePath) {
    std::cout << "Loading texture from file: " << filePath << std::endl;
 
-   if (texId)
-      glDeleteTextures(1, &texId);
+   if (texId) {
+      GlState::deleteTexture(texId);
+      texId = 0;
+   }
 
    FIBITMAP* bitmap = FreeImage_Load(FreeImage_GetFileType(filePath.c_str(), 0), filePath.c_str());
    if (!bitmap) {
@@ -83,7 +85,7 @@ bool ENG_API Eng::Texture::loadFromFile(const std::string& filePath) {
    }
 
    glGenTextures(1, &texId);
-   glBindTexture(GL_TEXTURE_2D, texId);
+   GlState::bindTexture(GL_TEXTURE_2D, texId);
 
    // Modern OpenGL texture loading
    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height,
@@ -155,7 +157,7 @@ void ENG_API Eng::Texture::setTextureId(std::string filepath) {
  */
 bool ENG_API Eng::Texture::render(glm::mat4 matrix, void* ptr) {
 
-   glBindTexture(GL_TEXTURE_2D, texId);
+   GlState::bindTexture(GL_TEXTURE_2D, texId);
 
    return true;
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+/**
+* @file transformStore.cpp
+* @brief Implementation of the TransformStore class
+*
+* This file contains the implementation of the TransformStore class methods.
+*
+* @see TransformStore
+* @see transformStore.h
+*
+* @date 2025
+*
+* @details The nodes are stored in topological (depth-first) order: a parent always comes before its
+* children and the subtree of a node is a contiguous range. The world matrix update is a single linear loop.
+* @see Eng::Node, Eng::List
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+#include "engine.h"
+
+/**
+* @brief Destructor
+*
+* Detaches all the nodes from the store.
+*/
+Eng::TransformStore::~TransformStore() {
+   clear();
+}
+
+/**
+* @brief Build the store from a list of roots
+*
+* Every node of every hierarchy is attached to the store, in topological order.
+*
+* @param roots The roots of the hierarchies to store.
+*/
+void ENG_API Eng::TransformStore::build(const std::list<Node*>& roots) {
+   clear();
+
+   for (Node* root : roots)
+      append(root, -1);
+
+   for (unsigned int i = 0; i < nodes.size(); i++)
+      nodes[i]->attachToStore(this, i);
+
+   valid = true;
+}
+
+/**
+* @brief Append a node and its subtree to the arrays
+*
+* @param node The node to append.
+* @param parentIndex The index of its parent, -1 for a root.
+*/
+void Eng::TransformStore::append(Node* node, int parentIndex) {
+   unsigned int index = (unsigned int)nodes.size();
+
+   parents.push_back(parentIndex);
+   subtreeSizes.push_back(1);
+   locals.push_back(node->getTransform());
+   worlds.push_back(glm::mat4(1.0f));
+   dirty.push_back(1);
+   nodes.push_back(node);
+
+   for (Node* child : node->getChildSpan())
+      append(child, (int)index);
+
+   subtreeSizes[index] = (unsigned int)nodes.size() - index;
+}
+
+/**
+* @brief Clear the store
+*
+* Detaches all the nodes and releases the arrays.
+*/
+void ENG_API Eng::TransformStore::clear() {
+   for (unsigned int i = 0; i < nodes.size(); i++)
+      nodes[i]->detachFromStore();
+
+   parents.clear();
+   subtreeSizes.clear();
+   locals.clear();
+   worlds.clear();
+   dirty.clear();
+   nodes.clear();
+   valid = false;
+}
+
+/**
+* @brief Update the world matrices
+*
+* Linear pass over the arrays: each dirty entry is computed from the world matrix of its parent,
+* which always comes first.
+*/
+void ENG_API Eng::TransformStore::update() {
+   const unsigned int count = (unsigned int)nodes.size();
+   for (unsigned int i = 0; i < count; i++) {
+      if (!dirty[i])
+         continue;
+
+      const int parent = parents[i];
+      if (parent >= 0)
+         worlds[i] = worlds[parent] * locals[i];
+      else
+         worlds[i] = locals[i];
+      nodes[i]->updateWorldBounds(worlds[i]);
+      dirty[i] = 0;
+   }
+}
+
+/**
+* @brief Set the local matrix of an entry
+*
+* The entry and its whole subtree are marked as dirty.
+*
+* @param index The entry index.
+* @param local The new local matrix.
+*/
+void ENG_API Eng::TransformStore::setLocal(unsigned int index, const glm::mat4& local) {
+   locals[index] = local;
+   setDirty(index);
+}
+
+/**
+* @brief Mark an entry and its subtree as dirty
+*
+* @param index The entry index.
+*/
+void ENG_API Eng::TransformStore::setDirty(unsigned int index) {
+   std::fill(dirty.begin() + index, dirty.begin() + index + subtreeSizes[index], (unsigned char)1);
+}
+
+/**
+* @brief Get the world matrix of an entry
+*
+* If the entry is still dirty the matrix is computed from its parent.
+*
+* @param index The entry index.
+* @return The world matrix.
+*/
+const glm::mat4 ENG_API& Eng::TransformStore::getWorld(unsigned int index) {
+   if (dirty[index]) {
+      const int parent = parents[index];
+      if (parent >= 0)
+         worlds[index] = getWorld(parent) * locals[index];
+      else
+         worlds[index] = locals[index];
+      nodes[index]->updateWorldBounds(worlds[index]);
+      dirty[index] = 0;
+   }
+   return worlds[index];
+}
@@ -0,0 +1,153 @@
+/**
+* @file transformStore.h
+* @brief TransformStore class header file
+*
+* This file contains the definition of the TransformStore class that keeps the transforms of a scene
+* in flat, contiguous arrays.
+*
+* @date 2025
+*
+* @details The nodes are stored in topological (depth-first) order: a parent always comes before its
+* children and the subtree of a node is a contiguous range. The world matrix update is a single linear loop.
+* @see Eng::Node, Eng::List
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+
+#ifndef TRANSFORM_STORE_H
+#define TRANSFORM_STORE_H
+
+#include "engine.h"
+
+/**
+* @brief TransformStore class
+*
+* Structure-of-arrays storage for parent indices, local and world matrices of a scene graph.
+*/
+class ENG_API TransformStore {
+public:
+   /**
+   * @brief Constructor
+   *
+   * Initializes an empty store.
+   */
+   TransformStore() {};
+
+   /**
+   * @brief Destructor
+   *
+   * Detaches all the nodes from the store.
+   */
+   ~TransformStore();
+
+   /**
+   * @brief Build the store from a list of roots
+   *
+   * Every node of every hierarchy is attached to the store, in topological order.
+   *
+   * @param roots The roots of the hierarchies to store.
+   */
+   void build(const std::list<Eng::Node*>& roots);
+
+   /**
+   * @brief Clear the store
+   *
+   * Detaches all the nodes and releases the arrays.
+   */
+   void clear();
+
+   /**
+   * @brief Update the world matrices
+   *
+   * Linear pass over the arrays: each dirty entry is computed from the world matrix of its parent,
+   * which always comes first.
+   */
+   void update();
+
+   /**
+   * @brief Set the local matrix of an entry
+   *
+   * The entry and its whole subtree are marked as dirty.
+   *
+   * @param index The entry index.
+   * @param local The new local matrix.
+   */
+   void setLocal(unsigned int index, const glm::mat4& local);
+
+   /**
+   * @brief Mark an entry and its subtree as dirty
+   *
+   * @param index The entry index.
+   */
+   void setDirty(unsigned int index);
+
+   /**
+   * @brief Get the world matrix of an entry
+   *
+   * If the entry is still dirty the matrix is computed from its parent.
+   *
+   * @param index The entry index.
+   * @return The world matrix.
+   */
+   const glm::mat4& getWorld(unsigned int index);
+
+   /**
+   * @brief Flag the hierarchy as changed
+   *
+   * Called when a child is added to a stored node: the store has to be rebuilt.
+   */
+   void invalidate() { valid = false; }
+
+   /**
+   * @brief Check if the store matches the hierarchy
+   *
+   * @return True if the store does not need to be rebuilt.
+   */
+   bool isValid() const { return valid; }
+
+   /**
+   * @brief Get the number of stored nodes
+   *
+   * @return The number of entries.
+   */
+   unsigned int size() const { return (unsigned int)nodes.size(); }
+
+   /**
+   * @brief Get the stored node at an index
+   *
+   * @param index The entry index.
+   * @return Pointer to the node.
+   */
+   Eng::Node* getNode(unsigned int index) const { return nodes[index]; }
+
+   /**
+   * @brief Get the parent index of an entry
+   *
+   * @param index The entry index.
+   * @return The parent index, -1 for a root.
+   */
+   int getParentIndex(unsigned int index) const { return parents[index]; }
+
+private:
+   /**
+   * @brief Append a node and its subtree to the arrays
+   *
+   * @param node The node to append.
+   * @param parentIndex The index of its parent, -1 for a root.
+   */
+   void append(Eng::Node* node, int parentIndex);
+
+   std::vector<int> parents; /**< Parent index of each entry (-1 for roots) */
+   std::vector<unsigned int> subtreeSizes; /**< Number of entries in the subtree of each entry (itself included) */
+   std::vector<glm::mat4> locals; /**< Local matrices */
+   std::vector<glm::mat4> worlds; /**< World matrices */
+   std::vector<unsigned char> dirty; /**< Dirty flags */
+   std::vector<Eng::Node*> nodes; /**< The stored nodes */
+   bool valid = false; /**< False when the hierarchy changed after the build */
+};
+
+#endif // TRANSFORM_STORE_H
@@ -0,0 +1,225 @@
+/**
+* @file uniformBuffers.cpp
+* @brief Implementation of the UniformBuffers class
+*
+* This file contains the implementation of the UniformBuffers class methods.
+*
+* @see UniformBuffers
+* @see uniformBuffers.h
+*
+* @date 2025
+*
+* @details The frame and light buffers are re-specified at every upload (the driver orphans the storage
+* still read by the previous frame), the material buffer only grows.
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+#include <GL/glew.h>
+#include "engine.h"
+
+/////////////
+// STATICS //
+/////////////
+
+/**
+* @brief A uniform buffer holding an array of blocks
+*/
+struct BlockBuffer {
+   unsigned int buffer = 0; /**< The buffer, 0 before init() */
+   unsigned int blockSize = 0; /**< Size of a block */
+   unsigned int stride = 0; /**< Distance between two slots, aligned for glBindBufferRange() */
+   unsigned int capacity = 0; /**< Slots allocated in the buffer */
+};
+
+static BlockBuffer buffers[Eng::UniformBuffers::BINDING_LAST]; /**< The buffers, per binding point */
+static std::vector<Eng::MaterialBlock> materials; /**< The material blocks, per slot */
+static std::vector<unsigned char> staging; /**< Blocks spread to the slot stride */
+
+/**
+* @brief Upload blocks to consecutive slots
+*
+* @param binding The binding point of the buffer.
+* @param blocks The blocks, packed.
+* @param first The first slot.
+* @param count The number of blocks.
+* @param respecify True to replace the whole storage with the blocks (the first slot must be 0).
+*/
+static void upload(unsigned int binding, const void* blocks, unsigned int first, unsigned int count, bool respecify) {
+   BlockBuffer& target = buffers[binding];
+   if (target.buffer == 0 || count == 0)
+      return;
+
+   staging.resize((size_t)count * target.stride);
+   for (unsigned int i = 0; i < count; i++)
+      memcpy(staging.data() + (size_t)i * target.stride, (const unsigned char*)blocks + (size_t)i * target.blockSize, target.blockSize);
+
+   glBindBuffer(GL_UNIFORM_BUFFER, target.buffer);
+   if (respecify) {
+      glBufferData(GL_UNIFORM_BUFFER, staging.size(), staging.data(), GL_STREAM_DRAW);
+      target.capacity = count;
+   }
+   else
+      glBufferSubData(GL_UNIFORM_BUFFER, (size_t)first * target.stride, staging.size(), staging.data());
+   glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+/**
+* @brief Upload all the material blocks, growing the buffer
+*/
+static void uploadMaterials() {
+   BlockBuffer& target = buffers[Eng::UniformBuffers::BINDING_MATERIAL];
+   if (target.buffer == 0)
+      return;
+
+   target.capacity = std::max((unsigned int)materials.size(), std::max(target.capacity * 2, 64u));
+   glBindBuffer(GL_UNIFORM_BUFFER, target.buffer);
+   glBufferData(GL_UNIFORM_BUFFER, (size_t)target.capacity * target.stride, nullptr, GL_STATIC_DRAW);
+   glBindBuffer(GL_UNIFORM_BUFFER, 0);
+   upload(Eng::UniformBuffers::BINDING_MATERIAL, materials.data(), 0, (unsigned int)materials.size(), false);
+}
+
+/**
+* @brief Bind a slot of a buffer to its binding point
+*
+* @param binding The binding point of the buffer.
+* @param slot The slot.
+*/
+static void bindSlot(unsigned int binding, unsigned int slot) {
+   const BlockBuffer& target = buffers[binding];
+   if (target.buffer != 0 && slot < target.capacity)
+      Eng::GlState::bindUniformRange(binding, target.buffer, slot * target.stride, target.blockSize);
+}
+
+/**
+* @brief Create the buffers
+*
+* Called once after the context creation. The materials added before are uploaded here.
+*
+* @return True on success.
+*/
+bool ENG_API Eng::UniformBuffers::init() {
+   GLint alignment = 0;
+   glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+   alignment = std::max(alignment, 1);
+
+   const unsigned int blockSizes[BINDING_LAST] = { sizeof(FrameBlock), sizeof(LightBlock), sizeof(MaterialBlock) };
+   for (unsigned int binding = 0; binding < BINDING_LAST; binding++) {
+      BlockBuffer& target = buffers[binding];
+      if (target.buffer == 0)
+         glGenBuffers(1, &target.buffer);
+      if (target.buffer == 0) {
+         std::cout << "[ERROR] Unable to create the uniform buffers" << std::endl;
+         return false;
+      }
+      target.blockSize = blockSizes[binding];
+      target.stride = (blockSizes[binding] + alignment - 1) / alignment * alignment;
+      target.capacity = 0;
+   }
+
+   if (!materials.empty())
+      uploadMaterials();
+   return true;
+}
+
+/**
+* @brief Release the buffers
+*
+* The material blocks stay mirrored: the slots held by the materials remain valid after a new init().
+*/
+void ENG_API Eng::UniformBuffers::free() {
+   for (BlockBuffer& target : buffers) {
+      if (target.buffer != 0)
+         GlState::deleteBuffer(target.buffer);
+      target = BlockBuffer();
+   }
+   staging.clear();
+   staging.shrink_to_fit();
+}
+
+/**
+* @brief Upload the frame blocks
+*
+* One slot per eye, in a single upload.
+*
+* @param frames The blocks.
+*/
+void ENG_API Eng::UniformBuffers::setFrames(std::span<const FrameBlock> frames) {
+   upload(BINDING_FRAME, frames.data(), 0, (unsigned int)frames.size(), true);
+}
+
+/**
+* @brief Select a frame block
+*
+* @param slot The slot, the index of the eye.
+*/
+void ENG_API Eng::UniformBuffers::bindFrame(unsigned int slot) {
+   bindSlot(BINDING_FRAME, slot);
+}
+
+/**
+* @brief Upload the light blocks
+*
+* One slot per light, in a single upload.
+*
+* @param lights The blocks.
+*/
+void ENG_API Eng::UniformBuffers::setLights(std::span<const LightBlock> lights) {
+   upload(BINDING_LIGHT, lights.data(), 0, (unsigned int)lights.size(), true);
+}
+
+/**
+* @brief Select a light block
+*
+* @param slot The slot, the index of the light.
+*/
+void ENG_API Eng::UniformBuffers::bindLight(unsigned int slot) {
+   bindSlot(BINDING_LIGHT, slot);
+}
+
+/**
+* @brief Add a material block
+*
+* Identical blocks share a slot. Slots are never released: materials are added at load.
+*
+* @param material The block.
+* @return The slot.
+*/
+unsigned int ENG_API Eng::UniformBuffers::addMaterial(const MaterialBlock& material) {
+   const auto same = [&material](const MaterialBlock& other) {
+      return other.ambient == material.ambient && other.diffuse == material.diffuse &&
+         other.specular == material.specular && other.emission == material.emission;
+   };
+   const auto it = std::find_if(materials.begin(), materials.end(), same);
+   if (it != materials.end())
+      return (unsigned int)(it - materials.begin());
+
+   const unsigned int slot = (unsigned int)materials.size();
+   materials.push_back(material);
+   if (slot < buffers[BINDING_MATERIAL].capacity)
+      upload(BINDING_MATERIAL, &materials[slot], slot, 1, false);
+   else
+      uploadMaterials();
+   return slot;
+}
+
+/**
+* @brief Select a material block
+*
+* @param slot The slot returned by addMaterial().
+*/
+void ENG_API Eng::UniformBuffers::bindMaterial(unsigned int slot) {
+   bindSlot(BINDING_MATERIAL, slot);
+}
+
+/**
+* @brief Get the number of material slots
+*
+* @return The distinct materials added.
+*/
+unsigned int ENG_API Eng::UniformBuffers::getMaterialCount() {
+   return (unsigned int)materials.size();
+}
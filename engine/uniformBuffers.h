@@ -0,0 +1,151 @@
+/**
+* @file uniformBuffers.h
+* @brief UniformBuffers class header file
+*
+* This file contains the definition of the UniformBuffers class, the std140 uniform blocks shared
+* by the shaders: frame, light and material data.
+*
+* @date 2025
+*
+* @details Every block lives in one buffer holding an array of slots, aligned to
+* GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, and a slot is selected with glBindBufferRange():
+* - frame (binding 0): projection, view and eye position, one slot per eye, uploaded once per frame;
+* - light (binding 1): one slot per light, uploaded once per frame;
+* - material (binding 2): one slot per distinct material, uploaded when the material is loaded.
+* The GLSL declarations must match the block structs below, member by member.
+* @see Eng::Material, Eng::Light, Eng::List
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+
+#ifndef UNIFORM_BUFFERS_H
+#define UNIFORM_BUFFERS_H
+
+#include "engine.h"
+
+/**
+* @brief Frame block (std140), one per eye
+*/
+struct ENG_API FrameBlock {
+   glm::mat4 projection; /**< Projection matrix */
+   glm::mat4 view; /**< View matrix */
+   glm::vec4 eyePosition; /**< World position of the eye, w = 1 */
+};
+
+/**
+* @brief Light block (std140), one per light
+*/
+struct ENG_API LightBlock {
+   glm::vec4 position; /**< World position, w = 0 for directional lights */
+   glm::vec4 direction; /**< World direction of spot lights, w = 0 */
+   glm::vec4 ambient; /**< Ambient color */
+   glm::vec4 diffuse; /**< Diffuse color */
+   glm::vec4 specular; /**< Specular color */
+   glm::vec4 attenuation; /**< Constant, linear, quadratic attenuation and cosine of the spot cutoff */
+};
+
+/**
+* @brief Material block (std140), one per distinct material
+*/
+struct ENG_API MaterialBlock {
+   glm::vec4 ambient; /**< Ambient color */
+   glm::vec4 diffuse; /**< Diffuse color */
+   glm::vec4 specular; /**< Specular color, shininess in w */
+   glm::vec4 emission; /**< Emission color */
+};
+
+// std140 lays vec4 and mat4 members out without padding:
+static_assert(sizeof(FrameBlock) == 144 && sizeof(LightBlock) == 96 && sizeof(MaterialBlock) == 64, "std140 block size");
+
+/**
+* @brief UniformBuffers class
+*
+* Static owner of the uniform buffers of the engine context.
+*/
+class ENG_API UniformBuffers {
+public:
+   // Enums:
+   enum ///< Binding points of the blocks
+   {
+      BINDING_FRAME = 0,
+      BINDING_LIGHT,
+      BINDING_MATERIAL,
+      BINDING_LAST
+   };
+
+   /**
+   * @brief Create the buffers
+   *
+   * Called once after the context creation. The materials added before are uploaded here.
+   *
+   * @return True on success.
+   */
+   static bool init();
+
+   /**
+   * @brief Release the buffers
+   */
+   static void free();
+
+   /**
+   * @brief Upload the frame blocks
+   *
+   * One slot per eye, in a single upload.
+   *
+   * @param frames The blocks.
+   */
+   static void setFrames(std::span<const FrameBlock> frames);
+
+   /**
+   * @brief Select a frame block
+   *
+   * @param slot The slot, the index of the eye.
+   */
+   static void bindFrame(unsigned int slot);
+
+   /**
+   * @brief Upload the light blocks
+   *
+   * One slot per light, in a single upload.
+   *
+   * @param lights The blocks.
+   */
+   static void setLights(std::span<const LightBlock> lights);
+
+   /**
+   * @brief Select a light block
+   *
+   * @param slot The slot, the index of the light.
+   */
+   static void bindLight(unsigned int slot);
+
+   /**
+   * @brief Add a material block
+   *
+   * Identical blocks share a slot. Slots are never released: materials are added at load.
+   *
+   * @param material The block.
+   * @return The slot.
+   */
+   static unsigned int addMaterial(const MaterialBlock& material);
+
+   /**
+   * @brief Select a material block
+   *
+   * @param slot The slot returned by addMaterial().
+   */
+   static void bindMaterial(unsigned int slot);
+
+   /**
+   * @brief Get the number of material slots
+   *
+   * @return The distinct materials added.
+   */
+   static unsigned int getMaterialCount();
+};
+
+#endif // UNIFORM_BUFFERS_H
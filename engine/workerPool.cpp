@@ -0,0 +1,126 @@
+/**
+* @file workerPool.cpp
+* @brief Implementation of the WorkerPool class
+*
+* This file contains the implementation of the WorkerPool class methods.
+*
+* @see WorkerPool
+* @see workerPool.h
+*
+* @date 2025
+*
+* @details A job is published under the mutex and the workers are woken up through a generation counter;
+* the tasks themselves are distributed lock-free through an atomic counter.
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+#include "engine.h"
+
+/**
+* @brief Destructor
+*
+* Stops and joins the workers.
+*/
+Eng::WorkerPool::~WorkerPool() {
+   stop();
+}
+
+/**
+* @brief Start the pool
+*
+* Any previous worker is stopped first.
+*
+* @param threads The number of threads, the calling thread included (0 or 1 means serial).
+*/
+void ENG_API Eng::WorkerPool::start(unsigned int threads) {
+   stop();
+
+   quit = false;
+   for (unsigned int i = 1; i < threads; i++)
+      workers.emplace_back(&WorkerPool::workerLoop, this, generation);
+}
+
+/**
+* @brief Stop and join the workers
+*/
+void ENG_API Eng::WorkerPool::stop() {
+   if (workers.empty())
+      return;
+
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      quit = true;
+   }
+   wakeUp.notify_all();
+
+   for (std::thread& worker : workers)
+      worker.join();
+   workers.clear();
+}
+
+/**
+* @brief Run a task for every index in [0, count)
+*
+* Blocks until all the tasks are done.
+*
+* @param count The number of tasks.
+* @param task The task, called with the task index.
+*/
+void ENG_API Eng::WorkerPool::parallelFor(unsigned int count, const std::function<void(unsigned int)>& newTask) {
+   if (workers.empty() || count < 2) {
+      for (unsigned int i = 0; i < count; i++)
+         newTask(i);
+      return;
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      task = &newTask;
+      taskCount = count;
+      nextTask.store(0);
+      pending = (unsigned int)workers.size();
+      generation++;
+   }
+   wakeUp.notify_all();
+
+   runTasks();
+
+   std::unique_lock<std::mutex> lock(mutex);
+   done.wait(lock, [this] { return pending == 0; });
+   task = nullptr;
+}
+
+/**
+* @brief Main loop of a worker thread
+*
+* @param seen The last job generation known when the worker was started.
+*/
+void Eng::WorkerPool::workerLoop(unsigned int seen) {
+   for (;;) {
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         wakeUp.wait(lock, [this, seen] { return quit || generation != seen; });
+         if (quit)
+            return;
+         seen = generation;
+      }
+
+      runTasks();
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--pending == 0)
+         done.notify_one();
+   }
+}
+
+/**
+* @brief Run tasks until the shared counter is exhausted
+*/
+void Eng::WorkerPool::runTasks() {
+   for (unsigned int i = nextTask.fetch_add(1); i < taskCount; i = nextTask.fetch_add(1))
+      (*task)(i);
+}
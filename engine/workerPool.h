@@ -0,0 +1,104 @@
+/**
+* @file workerPool.h
+* @brief WorkerPool class header file
+*
+* This file contains the definition of the WorkerPool class, a small set of persistent threads used to run
+* the per-frame update stage in parallel.
+*
+* @date 2025
+*
+* @details The calling thread takes part in the work, so a pool of N threads owns N - 1 workers.
+* Tasks are picked from a shared counter: the assignment of tasks to threads changes from frame to frame,
+* so tasks must write disjoint data for the result to be deterministic.
+* @see Eng::List
+*
+ * @authors
+ * - Chris Ferrari [chris.ferrari@student.supsi.ch]
+ * - Veljko Markovic [veljko.markovic@student.supsi.ch]
+ * - Marco Bernasconi [marco.bernasconi@student.supsi.ch]
+ * - Jonathan Casadei [jonathan.casadei@student.supsi.ch]
+*/
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "engine.h"
+
+/**
+* @brief WorkerPool class
+*
+* Persistent worker threads running indexed tasks.
+*/
+class ENG_API WorkerPool {
+public:
+   /**
+   * @brief Constructor
+   *
+   * Initializes an empty pool: tasks run on the calling thread.
+   */
+   WorkerPool() {};
+
+   /**
+   * @brief Destructor
+   *
+   * Stops and joins the workers.
+   */
+   ~WorkerPool();
+
+   /**
+   * @brief Start the pool
+   *
+   * Any previous worker is stopped first.
+   *
+   * @param threads The number of threads, the calling thread included (0 or 1 means serial).
+   */
+   void start(unsigned int threads);
+
+   /**
+   * @brief Stop and join the workers
+   */
+   void stop();
+
+   /**
+   * @brief Get the number of threads
+   *
+   * @return The number of threads taking part in a parallelFor, the calling thread included.
+   */
+   unsigned int getThreadCount() const { return (unsigned int)workers.size() + 1; }
+
+   /**
+   * @brief Run a task for every index in [0, count)
+   *
+   * Blocks until all the tasks are done.
+   *
+   * @param count The number of tasks.
+   * @param task The task, called with the task index.
+   */
+   void parallelFor(unsigned int count, const std::function<void(unsigned int)>& task);
+
+private:
+   /**
+   * @brief Main loop of a worker thread
+   *
+   * @param seen The last job generation known when the worker was started.
+   */
+   void workerLoop(unsigned int seen);
+
+   /**
+   * @brief Run tasks until the shared counter is exhausted
+   */
+   void runTasks();
+
+   std::vector<std::thread> workers; /**< The worker threads */
+   std::mutex mutex; /**< Protects the job state */
+   std::condition_variable wakeUp; /**< Signals a new job (or the stop) to the workers */
+   std::condition_variable done; /**< Signals the end of a job to the caller */
+   const std::function<void(unsigned int)>* task = nullptr; /**< The current task */
+   unsigned int taskCount = 0; /**< The number of tasks of the current job */
+   std::atomic<unsigned int> nextTask{ 0 }; /**< The next task index to run */
+   unsigned int generation = 0; /**< Job counter, used to wake up the workers */
+   unsigned int pending = 0; /**< Workers still busy on the current job */
+   bool quit = false; /**< Stop flag */
+};
+
+#endif // WORKER_POOL_H